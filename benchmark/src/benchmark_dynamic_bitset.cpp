@@ -0,0 +1,106 @@
+#include <galToolbox/container/dynamic_bitset.hpp>
+
+#ifdef GAL_BENCHMARK_WITH_BOOST
+	#include <boost/dynamic_bitset.hpp>
+#endif
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string_view>
+
+using namespace gal::toolbox::container;
+
+namespace
+{
+	constexpr std::size_t bits = 1 << 20;
+	constexpr std::size_t rounds = 200;
+
+	template<typename Bitset>
+	Bitset make_bitset(const unsigned seed)
+	{
+		Bitset bitset(bits);
+		std::mt19937 random{seed};
+		// ~1/8 bits set, sparse enough that find_next has some work to do
+		for (std::size_t i = 0; i < bits / 8; ++i) { bitset.set(random() % bits); }
+		return bitset;
+	}
+
+	template<typename Function>
+	void measure(const std::string_view library, const std::string_view name, Function function)
+	{
+		// the checksum keeps the optimizer from dropping the work
+		std::uint64_t checksum = 0;
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < rounds; ++i) { checksum += function(); }
+		const auto end = std::chrono::steady_clock::now();
+
+		const auto seconds = std::chrono::duration<double>(end - begin).count();
+		std::cout << library << " " << name << ": "
+				<< static_cast<double>(bits) * rounds / seconds / 1'000'000'000 << " Gbits/s"
+				<< " (checksum " << checksum << ")\n";
+	}
+
+	template<typename Bitset>
+	void run(const std::string_view library)
+	{
+		const auto lhs = make_bitset<Bitset>(42);
+		const auto rhs = make_bitset<Bitset>(4242);
+		auto result = lhs;
+
+		measure(library,
+		        "count",
+		        [&]
+		        {
+			        // touch the bitset so the count cannot be hoisted out of the loop
+			        result.flip(result.count() % bits);
+			        return result.count();
+		        });
+		measure(library,
+		        "and",
+		        [&]
+		        {
+			        result = lhs;
+			        result &= rhs;
+			        return result.count();
+		        });
+		measure(library,
+		        "or",
+		        [&]
+		        {
+			        result = lhs;
+			        result |= rhs;
+			        return result.count();
+		        });
+		measure(library, "is_subset_of", [&] { return static_cast<std::uint64_t>(lhs.is_subset_of(lhs | rhs)); });
+		measure(library,
+		        "shift",
+		        [&]
+		        {
+			        result = lhs;
+			        result <<= 12345;
+			        result >>= 777;
+			        return result.count();
+		        });
+		measure(library,
+		        "find_next",
+		        [&]
+		        {
+			        std::uint64_t sum = 0;
+			        for (auto i = lhs.find_first(); i not_eq Bitset::npos; i = lhs.find_next(i)) { sum += i; }
+			        return sum;
+		        });
+	}
+}// namespace
+
+int main()
+{
+	run<basic_dynamic_bitset>("galToolbox");
+	#ifdef GAL_BENCHMARK_WITH_BOOST
+	run<boost::dynamic_bitset<std::uint64_t>>("boost");
+	#else
+	std::cout << "boost not found, skip boost::dynamic_bitset\n";
+	#endif
+}
@@ -0,0 +1,115 @@
+#include <galToolbox/container/fifo.hpp>
+#include <galToolbox/container/mpmc_fifo.hpp>
+#include <galToolbox/container/spsc_fifo.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace gal::toolbox::container;
+
+namespace
+{
+	constexpr std::size_t capacity = 1024;
+	constexpr std::size_t total_items = 1 << 22;
+
+	// big enough that two neighbouring elements share a cache line only without padding
+	struct payload
+	{
+		std::uint64_t id;
+		std::array<std::uint64_t, 3> data;
+	};
+
+	template<typename Fifo>
+	bool try_push(Fifo& fifo, const payload& p) { return fifo.push(p); }
+
+	template<typename Fifo>
+	bool try_pop(Fifo& fifo, payload& p)
+	{
+		if constexpr (requires { fifo.try_pop(p); }) { return fifo.try_pop(p); }
+		else { return fifo.pop(p, static_cast<typename Fifo::time_type>(-1)); }
+	}
+
+	template<typename Fifo>
+	void run(const std::string_view name, const std::size_t producers, const std::size_t consumers)
+	{
+		auto* fifo = new Fifo{};
+
+		std::atomic<bool> start{false};
+		std::atomic<std::size_t> consumed{0};
+		std::atomic<std::uint64_t> checksum{0};
+
+		const auto per_producer = total_items / producers;
+		const auto expected = per_producer * producers;
+
+		std::vector<std::thread> threads;
+		for (std::size_t p = 0; p < producers; ++p)
+		{
+			threads.emplace_back(
+					[&, p]
+					{
+						while (not start.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+
+						for (std::size_t i = 0; i < per_producer; ++i)
+						{
+							const payload item{p * per_producer + i, {}};
+							while (not try_push(*fifo, item)) { std::this_thread::yield(); }
+						}
+					});
+		}
+		for (std::size_t c = 0; c < consumers; ++c)
+		{
+			threads.emplace_back(
+					[&]
+					{
+						while (not start.load(std::memory_order_acquire)) { std::this_thread::yield(); }
+
+						payload item{};
+						std::uint64_t sum = 0;
+						while (consumed.load(std::memory_order_relaxed) < expected)
+						{
+							if (try_pop(*fifo, item))
+							{
+								sum += item.id;
+								consumed.fetch_add(1, std::memory_order_relaxed);
+							}
+							else { std::this_thread::yield(); }
+						}
+						checksum += sum;
+					});
+		}
+
+		const auto begin = std::chrono::steady_clock::now();
+		start.store(true, std::memory_order_release);
+		for (auto& thread: threads) { thread.join(); }
+		const auto end = std::chrono::steady_clock::now();
+
+		const auto seconds = std::chrono::duration<double>(end - begin).count();
+		const auto valid = checksum.load() == static_cast<std::uint64_t>(expected) * (expected - 1) / 2;
+
+		std::cout << name << " " << producers << "P" << consumers << "C: "
+				<< static_cast<double>(expected) / seconds / 1'000'000 << " Mitems/s"
+				<< (valid ? "" : " (checksum mismatch!)") << '\n';
+
+		delete fifo;
+	}
+}// namespace
+
+int main()
+{
+	std::cout << "hardware concurrency: " << std::thread::hardware_concurrency() << '\n';
+
+	run<fifo<payload, capacity>>("fifo", 1, 1);
+	run<fifo<payload, capacity, std::allocator<payload>, true>>("fifo(padded slot)", 1, 1);
+	run<spsc_fifo<payload, capacity>>("spsc_fifo", 1, 1);
+	run<mpmc_fifo<payload, capacity>>("mpmc_fifo", 1, 1);
+
+	run<fifo<payload, capacity>>("fifo", 4, 4);
+	run<fifo<payload, capacity, std::allocator<payload>, true>>("fifo(padded slot)", 4, 4);
+	run<mpmc_fifo<payload, capacity>>("mpmc_fifo", 4, 4);
+}
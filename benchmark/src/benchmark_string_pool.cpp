@@ -0,0 +1,58 @@
+#include <galToolbox/string/string_pool.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace gal::toolbox::string;
+
+namespace
+{
+	constexpr std::size_t total_strings = 1 << 19;
+	// small blocks, so that there are tens of thousands of them
+	constexpr std::size_t block_capacity = 512;
+
+	std::vector<std::string> make_strings()
+	{
+		std::mt19937 random{42};
+		std::vector<std::string> strings;
+		strings.reserve(total_strings);
+		// mostly short strings with some long ones, which leaves blocks with all kinds of available space
+		for (std::size_t i = 0; i < total_strings; ++i) { strings.emplace_back(random() % 8 == 0 ? 64 + random() % 192 : 1 + random() % 24, static_cast<char>('a' + i % 26)); }
+		return strings;
+	}
+
+	template<string_pool_block_policy Policy>
+	void run(const std::string_view name, const std::vector<std::string>& strings)
+	{
+		string_pool<char, true, std::char_traits<char>, Policy> pool{block_capacity};
+
+		// the checksum keeps the optimizer from dropping the work
+		std::uint64_t checksum = 0;
+
+		const auto begin = std::chrono::steady_clock::now();
+		for (const auto& str: strings) { checksum += pool.append(str).size(); }
+		const auto end = std::chrono::steady_clock::now();
+
+		std::uint64_t chars = 0;
+		for (const auto& str: strings) { chars += str.size() + 1; }
+
+		const auto seconds = std::chrono::duration<double>(end - begin).count();
+		std::cout << name << ": "
+				<< static_cast<double>(strings.size()) / seconds / 1'000'000 << " Mstrings/s, "
+				<< pool.size() << " blocks (" << static_cast<double>(chars) * 100 / static_cast<double>(pool.size() * block_capacity) << "% used)"
+				<< (checksum + strings.size() == chars ? "" : " (checksum mismatch!)") << '\n';
+	}
+}// namespace
+
+int main()
+{
+	const auto strings = make_strings();
+
+	run<string_pool_block_policy::size_class>("size_class", strings);
+	run<string_pool_block_policy::sorted>("sorted", strings);
+}
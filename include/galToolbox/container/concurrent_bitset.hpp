@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <galToolbox/container/dynamic_bitset.hpp>
+#include <galToolbox/utils/assert.hpp>
+
+namespace gal::toolbox::container
+{
+	/**
+	 * @brief a bitset that many threads can set/test at the same time without a lock (e.g. the "visited" markers of a parallel graph traversal)
+	 * @tparam Bits the number of bits if it is known at compile time (the blocks live inside the object),
+	 * or std::dynamic_extent to allocate them once in the ctor
+	 * @note the blocks are never reallocated behind our back (a fixed size bitset never reallocates at all),
+	 * only resize (dynamic size only) does it and must not run concurrently with anything else
+	 * @note every modifier is a single atomic read-modify-write on one block, the default memory order is acq_rel for them and acquire for the loads,
+	 * pass std::memory_order_relaxed if the bits are only markers and do not publish other data
+	*/
+	template<std::size_t Bits = std::dynamic_extent>
+	class concurrent_bitset
+	{
+	public:
+		using bit_trait = basic_dynamic_bitset::bit_trait;
+
+		using value_type = basic_dynamic_bitset::value_type;
+		using size_type = basic_dynamic_bitset::size_type;
+		using block_type = std::atomic<value_type>;
+
+		constexpr static size_type bits_of_type = basic_dynamic_bitset::bits_of_type;
+		constexpr static bool is_fixed_size = Bits not_eq std::dynamic_extent;
+
+		static_assert(block_type::is_always_lock_free, "the blocks must be lock free");
+
+		[[nodiscard]] constexpr static size_type blocks_needed(const size_type bits) noexcept { return (bits + bits_of_type - 1) / bits_of_type; }
+
+	private:
+		using container_type = std::conditional_t<is_fixed_size, std::array<block_type, blocks_needed(is_fixed_size ? Bits : 0)>, std::unique_ptr<block_type[]>>;
+
+		container_type blocks_{};
+		size_type size_{is_fixed_size ? Bits : 0};
+
+		[[nodiscard]] block_type& block_of(const size_type pos) noexcept
+		{
+			gal_assert(pos < size(), "pos out of range");
+			return blocks_[bit_trait::block_index(pos)];
+		}
+
+		[[nodiscard]] const block_type& block_of(const size_type pos) const noexcept
+		{
+			gal_assert(pos < size(), "pos out of range");
+			return blocks_[bit_trait::block_index(pos)];
+		}
+
+		/**
+		 * @brief mask of the valid bits in the last block (bits past size() are always 0)
+		 */
+		[[nodiscard]] value_type last_block_mask() const noexcept
+		{
+			const auto extra = size() % bits_of_type;
+			return extra == 0 ? compl value_type{0} : (value_type{1} << extra) - 1;
+		}
+
+	public:
+		/**
+		 * @brief construct a bitset, all bits are 0 (a dynamic size bitset is empty)
+		 */
+		concurrent_bitset() noexcept = default;
+
+		/**
+		 * @brief construct a dynamic size bitset, all bits are 0
+		 * @param size how many bits we hold
+		 */
+		explicit concurrent_bitset(const size_type size)
+			requires(not is_fixed_size)
+			: blocks_(std::make_unique<block_type[]>(blocks_needed(size))),
+			  size_(size) {}
+
+		// the blocks may be in use by other threads, copy them explicitly with to_dynamic_bitset if you need a snapshot
+		concurrent_bitset(const concurrent_bitset&) = delete;
+		concurrent_bitset& operator=(const concurrent_bitset&) = delete;
+		concurrent_bitset(concurrent_bitset&&) = delete;
+		concurrent_bitset& operator=(concurrent_bitset&&) = delete;
+
+		~concurrent_bitset() noexcept = default;
+
+		/**
+		 * @brief get size (bits we hold)
+		 * @return size
+		 */
+		[[nodiscard]] size_type size() const noexcept { return size_; }
+
+		/**
+		 * @brief get how many blocks we hold
+		 * @return block size
+		 */
+		[[nodiscard]] size_type block_size() const noexcept { return blocks_needed(size()); }
+
+		/**
+		 * @brief reallocate the blocks and keep the old bits (dynamic size only)
+		 * @param size new size
+		 * @note not thread safe, no other thread may access the bitset during the resize
+		 */
+		void resize(const size_type size)
+			requires(not is_fixed_size)
+		{
+			auto blocks = std::make_unique<block_type[]>(blocks_needed(size));
+			const auto shrink = blocks_needed(size) <= block_size();
+			const auto keep = std::min(blocks_needed(size), block_size());
+			for (size_type i = 0; i < keep; ++i) { blocks[i].store(blocks_[i].load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+			blocks_ = std::move(blocks);
+			size_ = size;
+			// the bits past the new size must be 0 (when growing, the old last block is not the last one anymore and keeps all its bits)
+			if (shrink and keep not_eq 0 and size % bits_of_type not_eq 0) { blocks_[keep - 1].fetch_and(last_block_mask(), std::memory_order_relaxed); }
+		}
+
+		/**
+		 * @brief check whether the bit at pos is set
+		 * @param pos pos
+		 * @param order memory order of the load
+		 * @return is set
+		 */
+		[[nodiscard]] bool test(const size_type pos, const std::memory_order order = std::memory_order_acquire) const noexcept { return (block_of(pos).load(order) bitand bit_trait::bit_mask(pos)) not_eq 0; }
+
+		/**
+		 * @brief set the bit at pos
+		 * @param pos pos
+		 * @param order memory order of the read-modify-write
+		 * @return whether the bit was set before (false means this call is the one that set it)
+		 */
+		bool test_and_set(const size_type pos, const std::memory_order order = std::memory_order_acq_rel) noexcept
+		{
+			const auto mask = bit_trait::bit_mask(pos);
+			auto& block = block_of(pos);
+			// a vertex is usually visited more often than it is marked, do not take the cache line exclusively if the bit is already set
+			// (we write nothing then, so only the acquire half of the order matters)
+			const auto load_order = order == std::memory_order_relaxed or order == std::memory_order_release ? std::memory_order_relaxed : std::memory_order_acquire;
+			if ((block.load(load_order) bitand mask) not_eq 0) { return true; }
+			return (block.fetch_or(mask, order) bitand mask) not_eq 0;
+		}
+
+		/**
+		 * @brief reset the bit at pos
+		 * @param pos pos
+		 * @param order memory order of the read-modify-write
+		 * @return whether the bit was set before
+		 */
+		bool test_and_reset(const size_type pos, const std::memory_order order = std::memory_order_acq_rel) noexcept
+		{
+			const auto mask = bit_trait::bit_mask(pos);
+			return (block_of(pos).fetch_and(compl mask, order) bitand mask) not_eq 0;
+		}
+
+		/**
+		 * @brief flip the bit at pos
+		 * @param pos pos
+		 * @param order memory order of the read-modify-write
+		 * @return whether the bit was set before
+		 */
+		bool test_and_flip(const size_type pos, const std::memory_order order = std::memory_order_acq_rel) noexcept
+		{
+			const auto mask = bit_trait::bit_mask(pos);
+			return (block_of(pos).fetch_xor(mask, order) bitand mask) not_eq 0;
+		}
+
+		void set(const size_type pos, const std::memory_order order = std::memory_order_acq_rel) noexcept { block_of(pos).fetch_or(bit_trait::bit_mask(pos), order); }
+
+		void reset(const size_type pos, const std::memory_order order = std::memory_order_acq_rel) noexcept { block_of(pos).fetch_and(compl bit_trait::bit_mask(pos), order); }
+
+		void flip(const size_type pos, const std::memory_order order = std::memory_order_acq_rel) noexcept { block_of(pos).fetch_xor(bit_trait::bit_mask(pos), order); }
+
+		/**
+		 * @brief load a whole block
+		 * @param index block index (bit_trait::block_index(pos))
+		 * @param order memory order of the load
+		 * @return block
+		 */
+		[[nodiscard]] value_type load_block(const size_type index, const std::memory_order order = std::memory_order_acquire) const noexcept
+		{
+			gal_assert(index < block_size(), "index out of range");
+			return blocks_[index].load(order);
+		}
+
+		/**
+		 * @brief set the bits of mask in a block at once (e.g. all the neighbours of a vertex that share a block)
+		 * @param index block index (bit_trait::block_index(pos))
+		 * @param mask bits to set
+		 * @param order memory order of the read-modify-write
+		 * @return the block before (mask bitand compl previous are the bits this call set)
+		 */
+		value_type fetch_or_block(const size_type index, const value_type mask, const std::memory_order order = std::memory_order_acq_rel) noexcept
+		{
+			gal_assert(index < block_size(), "index out of range");
+			gal_assert(index + 1 < block_size() or (mask bitand compl last_block_mask()) == 0, "mask out of range");
+			return blocks_[index].fetch_or(mask, order);
+		}
+
+		/**
+		 * @brief keep only the bits of mask in a block at once
+		 * @param index block index (bit_trait::block_index(pos))
+		 * @param mask bits to keep
+		 * @param order memory order of the read-modify-write
+		 * @return the block before
+		 */
+		value_type fetch_and_block(const size_type index, const value_type mask, const std::memory_order order = std::memory_order_acq_rel) noexcept
+		{
+			gal_assert(index < block_size(), "index out of range");
+			return blocks_[index].fetch_and(mask, order);
+		}
+
+		/**
+		 * @brief reset all bits
+		 * @param order memory order of the stores
+		 * @note every block is reset atomically, but not all of them at once
+		 */
+		void clear(const std::memory_order order = std::memory_order_release) noexcept
+		{
+			for (size_type i = 0; i < block_size(); ++i) { blocks_[i].store(0, order); }
+		}
+
+		/**
+		 * @brief count the set bits
+		 * @param order memory order of the loads
+		 * @return count
+		 * @note only a snapshot if other threads are working at the same time
+		 */
+		[[nodiscard]] size_type count(const std::memory_order order = std::memory_order_acquire) const noexcept
+		{
+			size_type total = 0;
+			for (size_type i = 0; i < block_size(); ++i) { total += static_cast<size_type>(std::popcount(blocks_[i].load(order))); }
+			return total;
+		}
+
+		[[nodiscard]] bool any(const std::memory_order order = std::memory_order_acquire) const noexcept
+		{
+			for (size_type i = 0; i < block_size(); ++i) { if (blocks_[i].load(order) not_eq 0) { return true; } }
+			return false;
+		}
+
+		[[nodiscard]] bool none(const std::memory_order order = std::memory_order_acquire) const noexcept { return not any(order); }
+
+		/**
+		 * @brief copy the bits into a basic_dynamic_bitset
+		 * @param order memory order of the loads
+		 * @return bitset
+		 * @note only a snapshot if other threads are working at the same time
+		 */
+		[[nodiscard]] basic_dynamic_bitset to_dynamic_bitset(const std::memory_order order = std::memory_order_acquire) const
+		{
+			std::vector<value_type> blocks(block_size());
+			for (size_type i = 0; i < block_size(); ++i) { blocks[i] = blocks_[i].load(order); }
+
+			basic_dynamic_bitset bitset{blocks.begin(), blocks.end()};
+			bitset.resize(size());
+			return bitset;
+		}
+	};
+}// namespace gal::toolbox::container
@@ -0,0 +1,756 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <galToolbox/utils/cpu_feature.hpp>
+
+#ifdef GAL_CPU_X86
+	#include <immintrin.h>
+#endif
+
+/**
+ * @brief the block kernels of basic_dynamic_bitset, they work on raw block arrays and are selected at runtime by the cpu features
+ * @note never call them during constant evaluation (except the constexpr ones), basic_dynamic_bitset keeps a plain loop for that
+*/
+namespace gal::toolbox::container::details
+{
+	using block_type = std::uint64_t;
+
+	/**
+	 * @brief std::is_constant_evaluated(), but it can be called from a function that is only constexpr in some configurations
+	 * (gcc warns that std::is_constant_evaluated() is always false when it is called directly from an inline function)
+	*/
+	[[nodiscard]] constexpr bool is_constant_evaluated() noexcept { return std::is_constant_evaluated(); }
+
+	/**
+	 * @brief below this number of blocks, the setup of the vector kernels costs more than it saves
+	*/
+	constexpr std::size_t simd_threshold_blocks = 32;
+
+	[[nodiscard]] inline std::size_t popcount_scalar(const block_type* data, const std::size_t size) noexcept
+	{
+		std::size_t total = 0;
+		for (std::size_t i = 0; i < size; ++i) { total += static_cast<std::size_t>(std::popcount(data[i])); }
+		return total;
+	}
+
+	#ifdef GAL_CPU_X86
+	/**
+	 * @brief the same as popcount_scalar, but std::popcount compiles into the popcnt instruction
+	*/
+	[[nodiscard]] GAL_TARGET("popcnt") inline std::size_t popcount_popcnt(const block_type* data, const std::size_t size) noexcept
+	{
+		std::size_t total = 0;
+		for (std::size_t i = 0; i < size; ++i) { total += static_cast<std::size_t>(std::popcount(data[i])); }
+		return total;
+	}
+
+	namespace avx2
+	{
+		/**
+		 * @brief count the bits of every 64-bit lane (nibble lookup + sum of absolute differences)
+		*/
+		[[nodiscard]] GAL_TARGET("avx2") inline __m256i popcount(const __m256i v) noexcept
+		{
+			const auto lookup = _mm256_setr_epi8(
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+					0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+			const auto low_mask = _mm256_set1_epi8(0x0f);
+
+			const auto low = _mm256_and_si256(v, low_mask);
+			const auto high = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+			const auto bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+			return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+		}
+
+		/**
+		 * @brief carry-save adder, add three bit vectors into a sum (low) and a carry (high) bit vector
+		*/
+		GAL_TARGET("avx2") inline void csa(__m256i& high, __m256i& low, const __m256i a, const __m256i b, const __m256i c) noexcept
+		{
+			const auto u = _mm256_xor_si256(a, b);
+			high = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+			low = _mm256_xor_si256(u, c);
+		}
+
+		[[nodiscard]] GAL_TARGET("avx2") inline __m256i load(const block_type* data, const std::size_t index) noexcept
+		{
+			return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data) + index);
+		}
+	}// namespace avx2
+
+	/**
+	 * @brief Harley-Seal population count, 16 vectors are reduced by a tree of carry-save adders before one real popcount
+	*/
+	[[nodiscard]] GAL_TARGET("avx2") inline std::size_t popcount_avx2(const block_type* data, const std::size_t size) noexcept
+	{
+		constexpr std::size_t blocks_per_vector = sizeof(__m256i) / sizeof(block_type);
+		const auto vectors = size / blocks_per_vector;
+
+		auto total = _mm256_setzero_si256();
+		auto ones = _mm256_setzero_si256();
+		auto twos = _mm256_setzero_si256();
+		auto fours = _mm256_setzero_si256();
+		auto eights = _mm256_setzero_si256();
+		__m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+
+		std::size_t i = 0;
+		for (; i + 16 <= vectors; i += 16)
+		{
+			avx2::csa(twos_a, ones, ones, avx2::load(data, i + 0), avx2::load(data, i + 1));
+			avx2::csa(twos_b, ones, ones, avx2::load(data, i + 2), avx2::load(data, i + 3));
+			avx2::csa(fours_a, twos, twos, twos_a, twos_b);
+			avx2::csa(twos_a, ones, ones, avx2::load(data, i + 4), avx2::load(data, i + 5));
+			avx2::csa(twos_b, ones, ones, avx2::load(data, i + 6), avx2::load(data, i + 7));
+			avx2::csa(fours_b, twos, twos, twos_a, twos_b);
+			avx2::csa(eights_a, fours, fours, fours_a, fours_b);
+			avx2::csa(twos_a, ones, ones, avx2::load(data, i + 8), avx2::load(data, i + 9));
+			avx2::csa(twos_b, ones, ones, avx2::load(data, i + 10), avx2::load(data, i + 11));
+			avx2::csa(fours_a, twos, twos, twos_a, twos_b);
+			avx2::csa(twos_a, ones, ones, avx2::load(data, i + 12), avx2::load(data, i + 13));
+			avx2::csa(twos_b, ones, ones, avx2::load(data, i + 14), avx2::load(data, i + 15));
+			avx2::csa(fours_b, twos, twos, twos_a, twos_b);
+			avx2::csa(eights_b, fours, fours, fours_a, fours_b);
+			avx2::csa(sixteens, eights, eights, eights_a, eights_b);
+
+			total = _mm256_add_epi64(total, avx2::popcount(sixteens));
+		}
+
+		total = _mm256_slli_epi64(total, 4);
+		total = _mm256_add_epi64(total, _mm256_slli_epi64(avx2::popcount(eights), 3));
+		total = _mm256_add_epi64(total, _mm256_slli_epi64(avx2::popcount(fours), 2));
+		total = _mm256_add_epi64(total, _mm256_slli_epi64(avx2::popcount(twos), 1));
+		total = _mm256_add_epi64(total, avx2::popcount(ones));
+
+		for (; i < vectors; ++i) { total = _mm256_add_epi64(total, avx2::popcount(avx2::load(data, i))); }
+
+		alignas(__m256i) std::uint64_t lanes[blocks_per_vector];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+
+		return static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+		       popcount_popcnt(data + vectors * blocks_per_vector, size - vectors * blocks_per_vector);
+	}
+
+	/**
+	 * @brief VPOPCNTQ counts eight blocks at once, the tail is handled by a masked load
+	*/
+	[[nodiscard]] GAL_TARGET("avx512f,avx512vpopcntdq") inline std::size_t popcount_avx512(const block_type* data, const std::size_t size) noexcept
+	{
+		constexpr std::size_t blocks_per_vector = sizeof(__m512i) / sizeof(block_type);
+
+		auto total = _mm512_setzero_si512();
+
+		std::size_t i = 0;
+		for (; i + blocks_per_vector <= size; i += blocks_per_vector) { total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_loadu_si512(data + i))); }
+
+		if (i < size)
+		{
+			const auto mask = static_cast<__mmask8>((1u << (size - i)) - 1);
+			total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_maskz_loadu_epi64(mask, data + i)));
+		}
+
+		// not _mm512_reduce_add_epi64, gcc's implementation triggers -Wuninitialized
+		alignas(__m512i) std::uint64_t lanes[blocks_per_vector];
+		_mm512_store_si512(lanes, total);
+
+		std::uint64_t sum = 0;
+		for (const auto lane: lanes) { sum += lane; }
+		return static_cast<std::size_t>(sum);
+	}
+	#endif
+
+	/**
+	 * @brief the block-wise boolean operations of basic_dynamic_bitset
+	*/
+	enum class block_operation
+	{
+		// lhs & rhs
+		bit_and,
+		// lhs | rhs
+		bit_or,
+		// lhs ^ rhs
+		bit_xor,
+		// lhs & ~rhs
+		bit_and_not
+	};
+
+	template<block_operation Operation>
+	[[nodiscard]] constexpr block_type apply(const block_type lhs, const block_type rhs) noexcept
+	{
+		if constexpr (Operation == block_operation::bit_and) { return lhs bitand rhs; }
+		else if constexpr (Operation == block_operation::bit_or) { return lhs bitor rhs; }
+		else if constexpr (Operation == block_operation::bit_xor) { return lhs xor rhs; }
+		else { return lhs bitand compl rhs; }
+	}
+
+	/**
+	 * @brief lhs[i] = lhs[i] op rhs[i]
+	*/
+	template<block_operation Operation>
+	inline void transform_scalar(block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		for (std::size_t i = 0; i < size; ++i) { lhs[i] = apply<Operation>(lhs[i], rhs[i]); }
+	}
+
+	/**
+	 * @brief is there any i that lhs[i] op rhs[i] is not zero (stop at the first one)
+	*/
+	template<block_operation Operation>
+	[[nodiscard]] inline bool any_scalar(const block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		for (std::size_t i = 0; i < size; ++i) { if (apply<Operation>(lhs[i], rhs[i]) not_eq 0) { return true; } }
+		return false;
+	}
+
+	#ifdef GAL_CPU_X86
+	namespace sse2
+	{
+		template<block_operation Operation>
+		[[nodiscard]] GAL_TARGET("sse2") inline __m128i apply(const __m128i lhs, const __m128i rhs) noexcept
+		{
+			if constexpr (Operation == block_operation::bit_and) { return _mm_and_si128(lhs, rhs); }
+			else if constexpr (Operation == block_operation::bit_or) { return _mm_or_si128(lhs, rhs); }
+			else if constexpr (Operation == block_operation::bit_xor) { return _mm_xor_si128(lhs, rhs); }
+			// andnot(a, b) is ~a & b
+			else { return _mm_andnot_si128(rhs, lhs); }
+		}
+	}// namespace sse2
+
+	namespace avx2
+	{
+		template<block_operation Operation>
+		[[nodiscard]] GAL_TARGET("avx2") inline __m256i apply(const __m256i lhs, const __m256i rhs) noexcept
+		{
+			if constexpr (Operation == block_operation::bit_and) { return _mm256_and_si256(lhs, rhs); }
+			else if constexpr (Operation == block_operation::bit_or) { return _mm256_or_si256(lhs, rhs); }
+			else if constexpr (Operation == block_operation::bit_xor) { return _mm256_xor_si256(lhs, rhs); }
+			// andnot(a, b) is ~a & b
+			else { return _mm256_andnot_si256(rhs, lhs); }
+		}
+	}// namespace avx2
+
+	template<block_operation Operation>
+	GAL_TARGET("sse2") inline void transform_sse2(block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		constexpr std::size_t blocks_per_vector = sizeof(__m128i) / sizeof(block_type);
+
+		std::size_t i = 0;
+		for (; i + blocks_per_vector <= size; i += blocks_per_vector)
+		{
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(lhs + i), sse2::apply<Operation>(a, b));
+		}
+		transform_scalar<Operation>(lhs + i, rhs + i, size - i);
+	}
+
+	template<block_operation Operation>
+	GAL_TARGET("avx2") inline void transform_avx2(block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		constexpr std::size_t blocks_per_vector = sizeof(__m256i) / sizeof(block_type);
+
+		std::size_t i = 0;
+		// two vectors per iteration, the loads of the second one hide the latency of the first one
+		for (; i + 2 * blocks_per_vector <= size; i += 2 * blocks_per_vector)
+		{
+			const auto a0 = avx2::load(lhs, i / blocks_per_vector);
+			const auto a1 = avx2::load(lhs, i / blocks_per_vector + 1);
+			const auto b0 = avx2::load(rhs, i / blocks_per_vector);
+			const auto b1 = avx2::load(rhs, i / blocks_per_vector + 1);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i), avx2::apply<Operation>(a0, b0));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lhs + i + blocks_per_vector), avx2::apply<Operation>(a1, b1));
+		}
+		transform_scalar<Operation>(lhs + i, rhs + i, size - i);
+	}
+
+	template<block_operation Operation>
+	[[nodiscard]] GAL_TARGET("sse2") inline bool any_sse2(const block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		constexpr std::size_t blocks_per_vector = sizeof(__m128i) / sizeof(block_type);
+
+		std::size_t i = 0;
+		for (; i + blocks_per_vector <= size; i += blocks_per_vector)
+		{
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i));
+			// there is no ptest before sse4.1
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(sse2::apply<Operation>(a, b), _mm_setzero_si128())) not_eq 0xffff) { return true; }
+		}
+		return any_scalar<Operation>(lhs + i, rhs + i, size - i);
+	}
+
+	template<block_operation Operation>
+	[[nodiscard]] GAL_TARGET("avx2") inline bool any_avx2(const block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		constexpr std::size_t blocks_per_vector = sizeof(__m256i) / sizeof(block_type);
+
+		std::size_t i = 0;
+		for (; i + blocks_per_vector <= size; i += blocks_per_vector)
+		{
+			const auto a = avx2::load(lhs, i / blocks_per_vector);
+			const auto b = avx2::load(rhs, i / blocks_per_vector);
+			if (const auto v = avx2::apply<Operation>(a, b); not _mm256_testz_si256(v, v)) { return true; }
+		}
+		return any_scalar<Operation>(lhs + i, rhs + i, size - i);
+	}
+	#endif
+
+	/**
+	 * @brief lhs[i] = lhs[i] op rhs[i] with the fastest kernel this cpu supports
+	 * @param lhs blocks to modify
+	 * @param rhs blocks
+	 * @param size how many blocks
+	*/
+	template<block_operation Operation>
+	inline void transform(block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		#ifdef GAL_CPU_X86
+		using kernel_type = void (*)(block_type*, const block_type*, std::size_t) noexcept;
+
+		static const auto kernel = [] {
+			const auto& feature = utils::this_cpu_feature();
+			if (feature.avx2) { return kernel_type{transform_avx2<Operation>}; }
+			if (feature.sse2) { return kernel_type{transform_sse2<Operation>}; }
+			return kernel_type{transform_scalar<Operation>};
+		}();
+
+		if (size < simd_threshold_blocks) { transform_scalar<Operation>(lhs, rhs, size); }
+		else { kernel(lhs, rhs, size); }
+		#else
+		transform_scalar<Operation>(lhs, rhs, size);
+		#endif
+	}
+
+	/**
+	 * @brief is there any i that lhs[i] op rhs[i] is not zero, with the fastest kernel this cpu supports
+	 * @param lhs blocks
+	 * @param rhs blocks
+	 * @param size how many blocks
+	 * @return result (stop at the first vector that is not zero)
+	*/
+	template<block_operation Operation>
+	[[nodiscard]] inline bool any(const block_type* lhs, const block_type* rhs, const std::size_t size) noexcept
+	{
+		#ifdef GAL_CPU_X86
+		using kernel_type = bool (*)(const block_type*, const block_type*, std::size_t) noexcept;
+
+		static const auto kernel = [] {
+			const auto& feature = utils::this_cpu_feature();
+			if (feature.avx2) { return kernel_type{any_avx2<Operation>}; }
+			if (feature.sse2) { return kernel_type{any_sse2<Operation>}; }
+			return kernel_type{any_scalar<Operation>};
+		}();
+
+		return size < simd_threshold_blocks ? any_scalar<Operation>(lhs, rhs, size) : kernel(lhs, rhs, size);
+		#else
+		return any_scalar<Operation>(lhs, rhs, size);
+		#endif
+	}
+
+	/**
+	 * @brief count the set bits of the blocks with the fastest kernel this cpu supports
+	 * @param data blocks
+	 * @param size how many blocks
+	 * @return set bits
+	*/
+	[[nodiscard]] inline std::size_t popcount(const block_type* data, const std::size_t size) noexcept
+	{
+		#ifdef GAL_CPU_X86
+		using kernel_type = std::size_t (*)(const block_type*, std::size_t) noexcept;
+
+		static const auto short_kernel = utils::this_cpu_feature().popcnt ? kernel_type{popcount_popcnt} : kernel_type{popcount_scalar};
+		static const auto long_kernel = [] {
+			const auto& feature = utils::this_cpu_feature();
+			if (feature.avx512_vpopcntdq) { return kernel_type{popcount_avx512}; }
+			if (feature.avx2) { return kernel_type{popcount_avx2}; }
+			return short_kernel;
+		}();
+
+		return size < simd_threshold_blocks ? short_kernel(data, size) : long_kernel(data, size);
+		#else
+		return popcount_scalar(data, size);
+		#endif
+	}
+
+	/**
+	 * @brief get the block i of (src << (blocks * 64 + bits)), the blocks outside src are 0
+	 * @note a bit moves to a higher index when shifting left, just like basic_dynamic_bitset::operator<<=
+	*/
+	[[nodiscard]] constexpr block_type shifted_left_block(const block_type* src, const std::size_t src_size, const std::size_t i, const std::size_t blocks, const std::size_t bits) noexcept
+	{
+		if (i < blocks) { return 0; }
+
+		const auto j = i - blocks;
+		block_type result = j < src_size ? src[j] << bits : 0;
+		if (bits not_eq 0 and j not_eq 0 and j - 1 < src_size) { result or_eq src[j - 1] >> (64 - bits); }
+		return result;
+	}
+
+	/**
+	 * @brief get the block i of (src >> (blocks * 64 + bits)), the blocks outside src are 0
+	*/
+	[[nodiscard]] constexpr block_type shifted_right_block(const block_type* src, const std::size_t src_size, const std::size_t i, const std::size_t blocks, const std::size_t bits) noexcept
+	{
+		const auto j = i + blocks;
+		if (j >= src_size) { return 0; }
+
+		block_type result = src[j] >> bits;
+		if (bits not_eq 0 and j + 1 < src_size) { result or_eq src[j + 1] << (64 - bits); }
+		return result;
+	}
+
+	/**
+	 * @brief dst[i] = (src << n)[i] | merge[i] (no merge if not Merge)
+	 * @note dst can be src and/or merge, every block is read before it is overwritten (from high to low)
+	*/
+	template<bool Merge>
+	constexpr void shift_left_scalar(block_type* dst, const std::size_t dst_size, const block_type* src, const std::size_t src_size, const std::size_t n, const block_type* merge) noexcept
+	{
+		const auto blocks = n / 64;
+		const auto bits = n % 64;
+
+		for (auto i = dst_size; i-- > 0;)
+		{
+			if constexpr (Merge) { dst[i] = shifted_left_block(src, src_size, i, blocks, bits) bitor merge[i]; }
+			else { dst[i] = shifted_left_block(src, src_size, i, blocks, bits); }
+		}
+	}
+
+	/**
+	 * @brief dst[i] = (src >> n)[i] | merge[i] (no merge if not Merge)
+	 * @note dst can be src and/or merge, every block is read before it is overwritten (from low to high)
+	*/
+	template<bool Merge>
+	constexpr void shift_right_scalar(block_type* dst, const std::size_t dst_size, const block_type* src, const std::size_t src_size, const std::size_t n, const block_type* merge) noexcept
+	{
+		const auto blocks = n / 64;
+		const auto bits = n % 64;
+
+		for (std::size_t i = 0; i < dst_size; ++i)
+		{
+			if constexpr (Merge) { dst[i] = shifted_right_block(src, src_size, i, blocks, bits) bitor merge[i]; }
+			else { dst[i] = shifted_right_block(src, src_size, i, blocks, bits); }
+		}
+	}
+
+	#ifdef GAL_CPU_X86
+	/**
+	 * @brief the funnel shift of four blocks at once, the blocks that have a full window are done by vectors and the edges are done by shifted_left_block
+	*/
+	template<bool Merge>
+	GAL_TARGET("avx2") inline void shift_left_avx2(block_type* dst, const std::size_t dst_size, const block_type* src, const std::size_t src_size, const std::size_t n, const block_type* merge) noexcept
+	{
+		const auto blocks = n / 64;
+		const auto bits = n % 64;
+		// a shift count of 64 gives 0, so bits == 0 needs no special case
+		const auto count = _mm_cvtsi64_si128(static_cast<long long>(bits));
+		const auto carry_count = _mm_cvtsi64_si128(static_cast<long long>(64 - bits));
+
+		const auto store = [&](const std::size_t i, const block_type block)
+		{
+			if constexpr (Merge) { dst[i] = block bitor merge[i]; }
+			else { dst[i] = block; }
+		};
+
+		// src[i - blocks] and src[i - blocks - 1] both exist in [first, last)
+		const auto first = blocks + 1;
+		const auto last = std::min(dst_size, src_size + blocks);
+
+		auto i = dst_size;
+		for (; i > last; --i) { store(i - 1, shifted_left_block(src, src_size, i - 1, blocks, bits)); }
+		for (; i >= first + 4; i -= 4)
+		{
+			const auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (i - 4 - blocks)));
+			const auto carry = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (i - 5 - blocks)));
+			auto result = _mm256_or_si256(_mm256_sll_epi64(low, count), _mm256_srl_epi64(carry, carry_count));
+			if constexpr (Merge) { result = _mm256_or_si256(result, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(merge + (i - 4)))); }
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (i - 4)), result);
+		}
+		for (; i > 0; --i) { store(i - 1, shifted_left_block(src, src_size, i - 1, blocks, bits)); }
+	}
+
+	template<bool Merge>
+	GAL_TARGET("avx2") inline void shift_right_avx2(block_type* dst, const std::size_t dst_size, const block_type* src, const std::size_t src_size, const std::size_t n, const block_type* merge) noexcept
+	{
+		const auto blocks = n / 64;
+		const auto bits = n % 64;
+		// a shift count of 64 gives 0, so bits == 0 needs no special case
+		const auto count = _mm_cvtsi64_si128(static_cast<long long>(bits));
+		const auto carry_count = _mm_cvtsi64_si128(static_cast<long long>(64 - bits));
+
+		// src[i + blocks] and src[i + blocks + 1] both exist in [0, last)
+		const auto last = src_size > blocks + 1 ? std::min(dst_size, src_size - blocks - 1) : 0;
+
+		std::size_t i = 0;
+		for (; i + 4 <= last; i += 4)
+		{
+			const auto low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (i + blocks)));
+			const auto carry = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + (i + blocks + 1)));
+			auto result = _mm256_or_si256(_mm256_srl_epi64(low, count), _mm256_sll_epi64(carry, carry_count));
+			if constexpr (Merge) { result = _mm256_or_si256(result, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(merge + i))); }
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), result);
+		}
+		for (; i < dst_size; ++i)
+		{
+			if constexpr (Merge) { dst[i] = shifted_right_block(src, src_size, i, blocks, bits) bitor merge[i]; }
+			else { dst[i] = shifted_right_block(src, src_size, i, blocks, bits); }
+		}
+	}
+	#endif
+
+	/**
+	 * @brief dst[i] = (src << n)[i] | merge[i] (no merge if not Merge) with the fastest kernel this cpu supports
+	 * @param dst blocks to write
+	 * @param dst_size how many blocks to write
+	 * @param src blocks to shift (can be dst)
+	 * @param src_size how many blocks of src
+	 * @param n how many bits to shift
+	 * @param merge blocks to or (can be dst or src, at least dst_size blocks), ignored if not Merge
+	*/
+	template<bool Merge>
+	inline void shift_left(block_type* dst, const std::size_t dst_size, const block_type* src, const std::size_t src_size, const std::size_t n, const block_type* merge = nullptr) noexcept
+	{
+		if constexpr (not Merge)
+		{
+			if (dst == src and dst_size == src_size and n % 64 == 0)
+			{
+				// whole blocks, just move them
+				const auto blocks = std::min(n / 64, dst_size);
+				std::memmove(dst + blocks, dst, (dst_size - blocks) * sizeof(block_type));
+				std::memset(dst, 0, blocks * sizeof(block_type));
+				return;
+			}
+		}
+
+		#ifdef GAL_CPU_X86
+		using kernel_type = void (*)(block_type*, std::size_t, const block_type*, std::size_t, std::size_t, const block_type*) noexcept;
+
+		static const auto kernel = utils::this_cpu_feature().avx2 ? kernel_type{shift_left_avx2<Merge>} : kernel_type{shift_left_scalar<Merge>};
+
+		if (dst_size < simd_threshold_blocks) { shift_left_scalar<Merge>(dst, dst_size, src, src_size, n, merge); }
+		else { kernel(dst, dst_size, src, src_size, n, merge); }
+		#else
+		shift_left_scalar<Merge>(dst, dst_size, src, src_size, n, merge);
+		#endif
+	}
+
+	/**
+	 * @brief dst[i] = (src >> n)[i] | merge[i] (no merge if not Merge) with the fastest kernel this cpu supports
+	 * @param dst blocks to write
+	 * @param dst_size how many blocks to write
+	 * @param src blocks to shift (can be dst)
+	 * @param src_size how many blocks of src
+	 * @param n how many bits to shift
+	 * @param merge blocks to or (can be dst or src, at least dst_size blocks), ignored if not Merge
+	*/
+	template<bool Merge>
+	inline void shift_right(block_type* dst, const std::size_t dst_size, const block_type* src, const std::size_t src_size, const std::size_t n, const block_type* merge = nullptr) noexcept
+	{
+		if constexpr (not Merge)
+		{
+			if (dst == src and dst_size == src_size and n % 64 == 0)
+			{
+				// whole blocks, just move them
+				const auto blocks = std::min(n / 64, dst_size);
+				std::memmove(dst, dst + blocks, (dst_size - blocks) * sizeof(block_type));
+				std::memset(dst + (dst_size - blocks), 0, blocks * sizeof(block_type));
+				return;
+			}
+		}
+
+		#ifdef GAL_CPU_X86
+		using kernel_type = void (*)(block_type*, std::size_t, const block_type*, std::size_t, std::size_t, const block_type*) noexcept;
+
+		static const auto kernel = utils::this_cpu_feature().avx2 ? kernel_type{shift_right_avx2<Merge>} : kernel_type{shift_right_scalar<Merge>};
+
+		if (dst_size < simd_threshold_blocks) { shift_right_scalar<Merge>(dst, dst_size, src, src_size, n, merge); }
+		else { kernel(dst, dst_size, src, src_size, n, merge); }
+		#else
+		shift_right_scalar<Merge>(dst, dst_size, src, src_size, n, merge);
+		#endif
+	}
+
+	/**
+	 * @brief convert a block between the native byte order and little endian (the byte order of the serialized blocks)
+	*/
+	[[nodiscard]] constexpr block_type to_little_endian(const block_type block) noexcept
+	{
+		if constexpr (std::endian::native == std::endian::little) { return block; }
+		else
+		{
+			block_type result = 0;
+			for (int i = 0; i < 8; ++i) { result or_eq ((block >> (i * 8)) bitand 0xff) << ((7 - i) * 8); }
+			return result;
+		}
+	}
+
+	constexpr char hex_digits[] = "0123456789abcdef";
+
+	/**
+	 * @brief get the value of a hex digit (0-9, a-f, A-F)
+	 * @return value, or 0xff if it is not a hex digit
+	*/
+	[[nodiscard]] constexpr std::uint8_t hex_value(const char c) noexcept
+	{
+		if (c >= '0' and c <= '9') { return static_cast<std::uint8_t>(c - '0'); }
+		if (c >= 'a' and c <= 'f') { return static_cast<std::uint8_t>(c - 'a' + 10); }
+		if (c >= 'A' and c <= 'F') { return static_cast<std::uint8_t>(c - 'A' + 10); }
+		return 0xff;
+	}
+
+	/**
+	 * @brief write 16 hex digits per block, the highest block and its highest digit first (the same order as to_string)
+	 * @param data blocks
+	 * @param size how many blocks
+	 * @param out at least 16 * size chars
+	*/
+	inline void hex_encode_scalar(const block_type* data, const std::size_t size, char* out) noexcept
+	{
+		for (std::size_t i = size; i > 0; --i)
+		{
+			const auto block = data[i - 1];
+			for (int d = 60; d >= 0; d -= 4) { *out++ = hex_digits[(block >> d) bitand 0xf]; }
+		}
+	}
+
+	/**
+	 * @brief the reverse of hex_encode_scalar
+	 * @param in 16 * size chars
+	 * @param size how many blocks
+	 * @param data blocks to write
+	 * @return false if there is any invalid digit (data is unspecified then)
+	*/
+	[[nodiscard]] inline bool hex_decode_scalar(const char* in, const std::size_t size, block_type* data) noexcept
+	{
+		// the value of a valid digit never has the high bits
+		std::uint8_t invalid = 0;
+		for (std::size_t i = size; i > 0; --i)
+		{
+			block_type block = 0;
+			for (int d = 0; d < 16; ++d)
+			{
+				const auto value = hex_value(*in++);
+				invalid or_eq value;
+				block = (block << 4) bitor (value bitand 0xf);
+			}
+			data[i - 1] = block;
+		}
+		return (invalid bitand 0xf0) == 0;
+	}
+
+	#ifdef GAL_CPU_X86
+	namespace avx2
+	{
+		/**
+		 * @brief reverse the 32 bytes of v (the highest block and its highest byte first)
+		*/
+		[[nodiscard]] GAL_TARGET("avx2") inline __m256i reverse_bytes(const __m256i v) noexcept
+		{
+			const auto reverse = _mm256_setr_epi8(
+					15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+					15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+			return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, reverse), 0x4e);
+		}
+
+		/**
+		 * @brief get the value of 32 hex digits, valid is cleared for every invalid digit
+		*/
+		[[nodiscard]] GAL_TARGET("avx2") inline __m256i hex_value(const __m256i chars, __m256i& valid) noexcept
+		{
+			const auto digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+			const auto is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+			// 'A' | 0x20 == 'a'
+			const auto alpha = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+			const auto is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, _mm256_set1_epi8(5)), alpha);
+
+			valid = _mm256_and_si256(valid, _mm256_or_si256(is_digit, is_alpha));
+			return _mm256_blendv_epi8(_mm256_add_epi8(alpha, _mm256_set1_epi8(10)), digit, is_digit);
+		}
+	}// namespace avx2
+
+	/**
+	 * @brief the same as hex_encode_scalar, 4 blocks (64 digits) per iteration
+	*/
+	GAL_TARGET("avx2") inline void hex_encode_avx2(const block_type* data, const std::size_t size, char* out) noexcept
+	{
+		const auto digits = _mm256_setr_epi8(
+				'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+				'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+		const auto low_nibble = _mm256_set1_epi8(0x0f);
+
+		auto i = size;
+		for (; i >= 4; i -= 4, out += 64)
+		{
+			const auto v = avx2::reverse_bytes(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i - 4)));
+			const auto high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibble));
+			const auto low = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, low_nibble));
+			// two digits per byte, the high nibble first, unpack works in each 128-bit lane
+			const auto first = _mm256_unpacklo_epi8(high, low);
+			const auto second = _mm256_unpackhi_epi8(high, low);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_permute2x128_si256(first, second, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_permute2x128_si256(first, second, 0x31));
+		}
+		hex_encode_scalar(data, i, out);
+	}
+
+	/**
+	 * @brief the same as hex_decode_scalar, 4 blocks (64 digits) per iteration
+	*/
+	[[nodiscard]] GAL_TARGET("avx2") inline bool hex_decode_avx2(const char* in, const std::size_t size, block_type* data) noexcept
+	{
+		// (high nibble * 16 + low nibble) of every two digits
+		const auto weights = _mm256_set1_epi16(0x0110);
+
+		auto valid = _mm256_set1_epi8(-1);
+		auto i = size;
+		for (; i >= 4; i -= 4, in += 64)
+		{
+			const auto first = _mm256_maddubs_epi16(avx2::hex_value(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)), valid), weights);
+			const auto second = _mm256_maddubs_epi16(avx2::hex_value(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 32)), valid), weights);
+			// pack works in each 128-bit lane, put the 4 quarters back in order
+			const auto bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(first, second), 0xd8);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i - 4), avx2::reverse_bytes(bytes));
+		}
+		return _mm256_movemask_epi8(valid) == -1 and hex_decode_scalar(in, i, data);
+	}
+	#endif
+
+	/**
+	 * @brief hex_encode_scalar with the fastest kernel this cpu supports
+	*/
+	inline void hex_encode(const block_type* data, const std::size_t size, char* out) noexcept
+	{
+		#ifdef GAL_CPU_X86
+		using kernel_type = void (*)(const block_type*, std::size_t, char*) noexcept;
+
+		static const auto kernel = utils::this_cpu_feature().avx2 ? kernel_type{hex_encode_avx2} : kernel_type{hex_encode_scalar};
+
+		if (size < simd_threshold_blocks) { hex_encode_scalar(data, size, out); }
+		else { kernel(data, size, out); }
+		#else
+		hex_encode_scalar(data, size, out);
+		#endif
+	}
+
+	/**
+	 * @brief hex_decode_scalar with the fastest kernel this cpu supports
+	*/
+	[[nodiscard]] inline bool hex_decode(const char* in, const std::size_t size, block_type* data) noexcept
+	{
+		#ifdef GAL_CPU_X86
+		using kernel_type = bool (*)(const char*, std::size_t, block_type*) noexcept;
+
+		static const auto kernel = utils::this_cpu_feature().avx2 ? kernel_type{hex_decode_avx2} : kernel_type{hex_decode_scalar};
+
+		if (size < simd_threshold_blocks) { return hex_decode_scalar(in, size, data); }
+		return kernel(in, size, data);
+		#else
+		return hex_decode_scalar(in, size, data);
+		#endif
+	}
+}// namespace gal::toolbox::container::details
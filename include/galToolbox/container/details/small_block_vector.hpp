@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gal::toolbox::container::details
+{
+	/**
+	 * @brief a std::vector-like container of blocks that keeps up to InlineSize blocks inside itself and only goes to the heap past that
+	 * @tparam T block type
+	 * @tparam InlineSize how many blocks we can hold without allocating
+	 * @note the blocks are either all inline or all on the heap, so data() is always contiguous,
+	 * the heap keeps its capacity when we shrink back to inline (like std::vector::clear), call shrink_to_fit to release it
+	*/
+	template<typename T, std::size_t InlineSize>
+		requires std::is_trivial_v<T>
+	class small_block_vector
+	{
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using iterator = pointer;
+		using const_iterator = const_pointer;
+
+		using heap_type = std::vector<value_type>;
+
+		constexpr static size_type inline_size = InlineSize;
+
+	private:
+		std::array<value_type, inline_size> inline_{};
+		heap_type heap_;
+		size_type size_{0};
+
+		[[nodiscard]] constexpr bool on_heap() const noexcept { return size_ > inline_size; }
+
+		/**
+		 * @brief move all blocks from the inline storage to the heap, leave room for at least capacity blocks
+		 */
+		constexpr void spill(const size_type capacity)
+		{
+			heap_.reserve(std::max(capacity, inline_size * 2));
+			heap_.assign(inline_.begin(), inline_.begin() + static_cast<difference_type>(size_));
+		}
+
+		/**
+		 * @brief move the first size blocks from the heap back to the inline storage
+		 */
+		constexpr void unspill(const size_type size) noexcept
+		{
+			// std::array<T, 0>::data() may be nullptr
+			if constexpr (inline_size not_eq 0) { std::copy_n(heap_.begin(), size, inline_.begin()); }
+			heap_.clear();
+		}
+
+	public:
+		constexpr small_block_vector() noexcept = default;
+
+		constexpr explicit small_block_vector(const size_type size, const value_type value = value_type{}) { resize(size, value); }
+
+		template<std::input_iterator InputIterator>
+		constexpr small_block_vector(InputIterator first, InputIterator last) { assign(first, last); }
+
+		constexpr small_block_vector(const small_block_vector&) = default;
+		constexpr small_block_vector& operator=(const small_block_vector&) = default;
+
+		constexpr small_block_vector(small_block_vector&& other) noexcept
+			: inline_(other.inline_),
+			  heap_(std::move(other.heap_)),
+			  size_(std::exchange(other.size_, 0)) {}
+
+		constexpr small_block_vector& operator=(small_block_vector&& other) noexcept
+		{
+			if (std::addressof(other) == this) { return *this; }
+			inline_ = other.inline_;
+			heap_ = std::move(other.heap_);
+			other.heap_.clear();
+			size_ = std::exchange(other.size_, 0);
+			return *this;
+		}
+
+		constexpr ~small_block_vector() noexcept = default;
+
+		[[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+
+		[[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+
+		[[nodiscard]] constexpr size_type max_size() const noexcept { return heap_.max_size(); }
+
+		[[nodiscard]] constexpr size_type capacity() const noexcept { return std::max(inline_size, heap_.capacity()); }
+
+		[[nodiscard]] constexpr pointer data() noexcept { return on_heap() ? heap_.data() : inline_.data(); }
+
+		[[nodiscard]] constexpr const_pointer data() const noexcept { return on_heap() ? heap_.data() : inline_.data(); }
+
+		[[nodiscard]] constexpr iterator begin() noexcept { return data(); }
+
+		[[nodiscard]] constexpr const_iterator begin() const noexcept { return data(); }
+
+		[[nodiscard]] constexpr iterator end() noexcept { return data() + size_; }
+
+		[[nodiscard]] constexpr const_iterator end() const noexcept { return data() + size_; }
+
+		[[nodiscard]] constexpr reference operator[](const size_type index) noexcept { return data()[index]; }
+
+		[[nodiscard]] constexpr const_reference operator[](const size_type index) const noexcept { return data()[index]; }
+
+		[[nodiscard]] constexpr reference back() noexcept { return data()[size_ - 1]; }
+
+		[[nodiscard]] constexpr const_reference back() const noexcept { return data()[size_ - 1]; }
+
+		constexpr void reserve(const size_type capacity)
+		{
+			// the heap is empty when we are inline, reserve it so that the next spill does not allocate
+			if (capacity > inline_size) { heap_.reserve(capacity); }
+		}
+
+		constexpr void shrink_to_fit()
+		{
+			if (on_heap()) { heap_.shrink_to_fit(); }
+			else { heap_ = heap_type{}; }
+		}
+
+		constexpr void resize(const size_type size, const value_type value = value_type{})
+		{
+			if (size <= inline_size)
+			{
+				if (on_heap()) { unspill(size); }
+				else if (size > size_) { std::fill(inline_.begin() + static_cast<difference_type>(size_), inline_.begin() + static_cast<difference_type>(size), value); }
+			}
+			else
+			{
+				if (not on_heap()) { spill(size); }
+				heap_.resize(size, value);
+			}
+			size_ = size;
+		}
+
+		constexpr void push_back(const value_type value)
+		{
+			if (size_ < inline_size) { inline_[size_] = value; }
+			else
+			{
+				if (size_ == inline_size) { spill(size_ + 1); }
+				heap_.push_back(value);
+			}
+			++size_;
+		}
+
+		constexpr void pop_back() noexcept
+		{
+			if (size_ == inline_size + 1) { unspill(inline_size); }
+			else if (on_heap()) { heap_.pop_back(); }
+			--size_;
+		}
+
+		constexpr void clear() noexcept
+		{
+			heap_.clear();
+			size_ = 0;
+		}
+
+		template<std::input_iterator InputIterator>
+		constexpr void assign(InputIterator first, InputIterator last)
+		{
+			clear();
+			if constexpr (std::forward_iterator<InputIterator>)
+			{
+				if (const auto size = static_cast<size_type>(std::distance(first, last)); size > inline_size)
+				{
+					heap_.assign(first, last);
+					size_ = size;
+					return;
+				}
+			}
+			for (; first not_eq last; ++first) { push_back(static_cast<value_type>(*first)); }
+		}
+
+		constexpr void swap(small_block_vector& other) noexcept
+		{
+			std::ranges::swap(inline_, other.inline_);
+			heap_.swap(other.heap_);
+			std::ranges::swap(size_, other.size_);
+		}
+
+		constexpr friend void swap(small_block_vector& lhs, small_block_vector& rhs) noexcept { lhs.swap(rhs); }
+
+		[[nodiscard]] constexpr friend bool operator==(const small_block_vector& lhs, const small_block_vector& rhs) noexcept { return std::ranges::equal(lhs, rhs); }
+	};
+}// namespace gal::toolbox::container::details
@@ -1,26 +1,87 @@
 #pragma once
 
-#ifndef _MSC_VER
-// gcc/clang not support 'constexpr vector' yet
-#define GALTOOLBOX_DYNAMIC_BITSET_NOT_SUPPORTED
-#endif
-
-#ifndef GALTOOLBOX_DYNAMIC_BITSET_NOT_SUPPORTED
-
+#include <algorithm>
 #include <array>
-#include <iosfwd>
+#include <bit>
+#include <cstring>
+#include <istream>
+#include <limits>
 #include <locale>
 #include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 #include <ranges>
-#include <numeric>
 
+#include <galToolbox/container/details/dynamic_bitset_kernel.hpp>
+#include <galToolbox/container/details/small_block_vector.hpp>
 #include <galToolbox/functional/zip_invoke.hpp>
 #include <galToolbox/utils/assert.hpp>
 
+// constexpr std::vector (libstdc++ 12, libc++ 15, msvc 19.29), define GALTOOLBOX_DYNAMIC_BITSET_NO_CONSTEXPR to test the fallback
+#if defined(__cpp_lib_constexpr_vector) and not defined(GALTOOLBOX_DYNAMIC_BITSET_NO_CONSTEXPR)
+	#define GALTOOLBOX_DYNAMIC_BITSET_CONSTEXPR_SUPPORTED
+#endif
+
+/**
+ * @brief everything that touches the std::vector is only constexpr if the standard library supports constexpr std::vector,
+ * otherwise it is a plain inline function (clang rejects a constexpr function that can never be a constant expression)
+*/
+#ifdef GALTOOLBOX_DYNAMIC_BITSET_CONSTEXPR_SUPPORTED
+	#define GAL_DYNAMIC_BITSET_CONSTEXPR constexpr
+	#define GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR GAL_ASSERT_CONSTEXPR
+#else
+	#define GAL_DYNAMIC_BITSET_CONSTEXPR inline
+	#define GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR inline
+#endif
+
+/**
+ * @brief how many blocks (64 bits each) a basic_dynamic_bitset holds without allocating, 0 always allocates like std::vector
+*/
+#ifndef GALTOOLBOX_DYNAMIC_BITSET_INLINE_BLOCKS
+	#define GALTOOLBOX_DYNAMIC_BITSET_INLINE_BLOCKS 4
+#endif
+
 namespace gal::toolbox::container
 {
+	class basic_dynamic_bitset;
+
+	/**
+	 * @brief a leaf of the lazy expressions, refer to (or own, if it is an rvalue) a basic_dynamic_bitset
+	*/
+	template<bool Owning>
+	class dynamic_bitset_leaf;
+
+	/**
+	 * @brief is T a lazy expression over basic_dynamic_bitset? (specialized by every expression type)
+	*/
+	template<typename T>
+	constexpr bool is_dynamic_bitset_expression_v = false;
+
+	template<typename T>
+	concept dynamic_bitset_expression = is_dynamic_bitset_expression_v<std::remove_cvref_t<T>>;
+
+	/**
+	 * @brief anything that can be an operand of the lazy expressions (a basic_dynamic_bitset or another expression)
+	*/
+	template<typename T>
+	concept dynamic_bitset_operand = std::is_same_v<std::remove_cvref_t<T>, basic_dynamic_bitset> or dynamic_bitset_expression<T>;
+
+	/**
+	 * @brief how basic_dynamic_bitset::serialize stores the blocks (after a header of the bit count and the encoding)
+	*/
+	enum class dynamic_bitset_encoding : std::uint8_t
+	{
+		// every block, little endian
+		raw = 0,
+		// (block, count) pairs of equal neighbouring blocks, for long runs of 0 or 1
+		run_length = 1,
+	};
+
 	class basic_dynamic_bitset
 	{
 	public:
@@ -29,11 +90,16 @@ namespace gal::toolbox::container
 		class bit_reference;
 		class bit_const_iterator;
 		class bit_iterator;
+		class set_bit_iterator;
 
 		friend class bit_reference;
 		friend class bit_iterator;
 
-		using container = std::vector<std::uint64_t>;
+		template<bool>
+		friend class dynamic_bitset_leaf;
+
+		// short bitsets (<= 256 bits by default) live inside the object, only the longer ones go to the heap
+		using container = details::small_block_vector<std::uint64_t, GALTOOLBOX_DYNAMIC_BITSET_INLINE_BLOCKS>;
 
 		using value_type = container::value_type;
 		using size_type = container::size_type;
@@ -102,7 +168,7 @@ namespace gal::toolbox::container
 			 * @param set set or reset
 			 * @return block after set
 			 */
-			[[nodiscard]] constexpr static value_type set_block_bits(
+			[[nodiscard]] GAL_ASSERT_CONSTEXPR static value_type set_block_bits(
 					const value_type block,
 					const size_type first,
 					const size_type last,
@@ -119,12 +185,12 @@ namespace gal::toolbox::container
 			 * @param last end for get mask
 			 * @return block after set
 			 */
-			[[nodiscard]] constexpr static value_type set_block_partial(const value_type block,
-			                                                            const size_type first,
-			                                                            const size_type last) noexcept(noexcept(set_block_bits(std::declval<value_type>(),
-			                                                                                                                   std::declval<size_type>(),
-			                                                                                                                   std::declval<size_type>(),
-			                                                                                                                   std::declval<bool>()))) { return set_block_bits(block, first, last, true); }
+			[[nodiscard]] GAL_ASSERT_CONSTEXPR static value_type set_block_partial(const value_type block,
+			                                                                       const size_type first,
+			                                                                       const size_type last) noexcept(noexcept(set_block_bits(std::declval<value_type>(),
+			                                                                                                                              std::declval<size_type>(),
+			                                                                                                                              std::declval<size_type>(),
+			                                                                                                                              std::declval<bool>()))) { return set_block_bits(block, first, last, true); }
 
 			/**
 			 * @brief set the block's value to full (wont change itself)
@@ -139,7 +205,7 @@ namespace gal::toolbox::container
 			 * @param last ebd for get mask
 			 * @return block after reset
 			 */
-			[[nodiscard]] constexpr static value_type reset_block_partial(
+			[[nodiscard]] GAL_ASSERT_CONSTEXPR static value_type reset_block_partial(
 					const value_type block,
 					const size_type first,
 					const size_type last) noexcept(noexcept(set_block_bits(std::declval<value_type>(),
@@ -297,39 +363,39 @@ namespace gal::toolbox::container
 
 			using iterator = real_iterator;
 			using const_iterator = real_const_iterator;
-			using iterator_category = iterator::iterator_category;
-			using difference_type = iterator::difference_type;
+			using iterator_category = std::iterator_traits<iterator>::iterator_category;
+			using difference_type = std::iterator_traits<iterator>::difference_type;
 
 		private:
-			constexpr bit_const_iterator(const const_iterator& it, const size_type offset)
+			GAL_DYNAMIC_BITSET_CONSTEXPR bit_const_iterator(const const_iterator& it, const size_type offset)
 			// NOLINT(clang-diagnostic-invalid-constexpr)
 				: iterator_(it),
 				  index_(offset) { }
 
 		public:
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR bit_const_iterator operator+(const size_type n) const noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_const_iterator operator+(const size_type n) const noexcept
 			{
 				gal_assert(index_ + n > index_, "offset overflow");
 				return {iterator_, index_ + n};
 			}
 
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR bit_const_iterator operator-(const size_type n) const noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_const_iterator operator-(const size_type n) const noexcept
 			{
 				gal_assert(index_ >= n, "offset underflow");
 				return {iterator_, index_ - n};
 			}
 
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR size_type distance(const bit_const_iterator& other) const noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR size_type distance(const bit_const_iterator& other) const noexcept
 			{
 				gal_assert(other.index_ <= index_, "target's offset greater than this");
 				return index_ - other.index_;
 			}
 
-			[[nodiscard]] constexpr bool operator==(const bit_const_iterator& other) const noexcept { return index_ == other.index_ and iterator_ == other.iterator_; }
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator==(const bit_const_iterator& other) const noexcept { return index_ == other.index_ and iterator_ == other.iterator_; }
 
-			[[nodiscard]] constexpr bool operator not_eq(const bit_const_iterator& other) const noexcept { return not this->operator==(other); }
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator not_eq(const bit_const_iterator& other) const noexcept { return not this->operator==(other); }
 
-			[[nodiscard]] constexpr value_type operator*() const noexcept// NOLINT(clang-diagnostic-invalid-constexpr)
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR value_type operator*() const noexcept// NOLINT(clang-diagnostic-invalid-constexpr)
 			{
 				return {*std::ranges::next(iterator_, static_cast<std::iter_difference_t<const_iterator>>(bit_trait::block_index(index_))), bit_trait::bit_index(index_)};
 			}
@@ -352,17 +418,17 @@ namespace gal::toolbox::container
 
 			using iterator = real_iterator;
 			using const_iterator = real_const_iterator;
-			using iterator_category = iterator::iterator_category;
-			using difference_type = iterator::difference_type;
+			using iterator_category = std::iterator_traits<iterator>::iterator_category;
+			using difference_type = std::iterator_traits<iterator>::difference_type;
 
 		private:
-			constexpr bit_iterator(const iterator& it, const size_type offset)
+			GAL_DYNAMIC_BITSET_CONSTEXPR bit_iterator(const iterator& it, const size_type offset)
 			// NOLINT(clang-diagnostic-invalid-constexpr)
 				: iterator_(it),
 				  index_(offset) { }
 
 		public:
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR bit_iterator operator++(int) noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator operator++(int) noexcept
 			{
 				gal_assert(index_ + 1 > index_, "offset overflow");
 				auto copy{*this};
@@ -370,14 +436,14 @@ namespace gal::toolbox::container
 				return copy;
 			}
 
-			GAL_ASSERT_CONSTEXPR bit_iterator& operator++() noexcept
+			GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator& operator++() noexcept
 			{
 				gal_assert(index_ + 1 > index_, "offset overflow");
 				++index_;
 				return *this;
 			}
 
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR bit_iterator operator--(int) noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator operator--(int) noexcept
 			{
 				gal_assert(index_ > 0, "offset underflow");
 				auto copy{*this};
@@ -385,81 +451,139 @@ namespace gal::toolbox::container
 				return copy;
 			}
 
-			GAL_ASSERT_CONSTEXPR bit_iterator& operator--() noexcept
+			GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator& operator--() noexcept
 			{
 				gal_assert(index_ > 0, "offset underflow");
 				--index_;
 				return *this;
 			}
 
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR bit_iterator operator+(const size_type n) const noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator operator+(const size_type n) const noexcept
 			{
 				gal_assert(index_ + n > index_, "offset overflow");
 				return {iterator_, index_ + n};
 			}
 
-			GAL_ASSERT_CONSTEXPR bit_iterator& operator+=(const size_type n) noexcept
+			GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator& operator+=(const size_type n) noexcept
 			{
 				gal_assert(index_ + n > index_, "offset overflow");
 				index_ += n;
 				return *this;
 			}
 
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR bit_iterator operator-(const size_type n) const noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator operator-(const size_type n) const noexcept
 			{
 				gal_assert(index_ >= n, "offset underflow");
 				return {iterator_, index_ - n};
 			}
 
-			GAL_ASSERT_CONSTEXPR bit_iterator& operator-=(const size_type n) noexcept
+			GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bit_iterator& operator-=(const size_type n) noexcept
 			{
 				gal_assert(index_ >= n, "offset underflow");
 				index_ -= n;
 				return *this;
 			}
 
-			[[nodiscard]] GAL_ASSERT_CONSTEXPR size_type distance(const bit_iterator& other) const noexcept
+			[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR size_type distance(const bit_iterator& other) const noexcept
 			{
 				gal_assert(other.index_ <= index_, "target's offset greater than this");
 				return index_ - other.index_;
 			}
 
-			[[nodiscard]] constexpr bool operator==(const bit_iterator& other) const noexcept { return index_ == other.index_ and iterator_ == other.iterator_; }
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator==(const bit_iterator& other) const noexcept { return index_ == other.index_ and iterator_ == other.iterator_; }
 
-			[[nodiscard]] constexpr bool operator not_eq(const bit_iterator& other) const noexcept { return not this->operator==(other); }
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator not_eq(const bit_iterator& other) const noexcept { return not this->operator==(other); }
 
-			[[nodiscard]] constexpr value_type operator*() const noexcept// NOLINT(clang-diagnostic-invalid-constexpr)
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR value_type operator*() const noexcept// NOLINT(clang-diagnostic-invalid-constexpr)
 			{
 				return {*std::ranges::next(iterator_, static_cast<std::iter_difference_t<iterator>>(bit_trait::block_index(index_))), bit_trait::bit_index(index_)};
 			}
 
 			// let IDE stop prompting us to add explicit for implicit conversion
 			// ReSharper disable once CppNonExplicitConversionOperator
-			[[nodiscard]] constexpr operator bit_const_iterator() const noexcept { return {iterator_, index_}; }
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR operator bit_const_iterator() const noexcept { return {iterator_, index_}; }
 
 		private:
 			iterator iterator_;
 			size_type index_;
 		};
 
+		/**
+		 * @brief iterate the indices of the set bits, skip a whole block if it has no set bit
+		 */
+		class set_bit_iterator
+		{
+			friend class basic_dynamic_bitset;
+
+		public:
+			using container = basic_dynamic_bitset;
+			using block_type = basic_dynamic_bitset::value_type;
+
+			// set_bit_iterator 's value_type is the index of bit
+			using value_type = size_type;
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::forward_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+
+			GAL_DYNAMIC_BITSET_CONSTEXPR set_bit_iterator() noexcept = default;
+
+		private:
+			GAL_DYNAMIC_BITSET_CONSTEXPR explicit set_bit_iterator(const container& bitset) noexcept
+				: bitset_(std::addressof(bitset)),
+				  block_(bitset.container_size() == 0 ? 0 : bitset.container_[0]) { skip_empty_blocks(); }
+
+			GAL_DYNAMIC_BITSET_CONSTEXPR void skip_empty_blocks() noexcept
+			{
+				while (block_ == 0 and ++block_index_ < bitset_->container_size()) { block_ = bitset_->container_[block_index_]; }
+			}
+
+		public:
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR value_type operator*() const noexcept { return block_index_ * bits_of_type + static_cast<size_type>(std::countr_zero(block_)); }
+
+			GAL_DYNAMIC_BITSET_CONSTEXPR set_bit_iterator& operator++() noexcept
+			{
+				// clear the lowest set bit
+				block_ and_eq block_ - 1;
+				skip_empty_blocks();
+				return *this;
+			}
+
+			GAL_DYNAMIC_BITSET_CONSTEXPR set_bit_iterator operator++(int) noexcept
+			{
+				auto copy{*this};
+				this->operator++();
+				return copy;
+			}
+
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator==(const set_bit_iterator& other) const noexcept { return block_index_ == other.block_index_ and block_ == other.block_; }
+
+			[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator==(std::default_sentinel_t) const noexcept { return block_ == 0; }
+
+		private:
+			const container* bitset_{nullptr};
+			size_type block_index_{0};
+			// the bits of the current block we have not visited yet
+			block_type block_{0};
+		};
+
 		/**
 		 * @brief get size (bits we hold, not container size)
 		 * @return bits we hold
 		 */
-		[[nodiscard]] constexpr size_type size() const noexcept { return total_; }
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type size() const noexcept { return total_; }
 
 		/**
 		 * @brief get container's real size we used
 		 * @return container's size
 		 */
-		[[nodiscard]] constexpr size_type container_size() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type container_size() const
 		noexcept(noexcept(std::declval<container>().size())) { return container_.size(); }
 
 		/**
 		 * @brief get the max bits we can hold (normally, bits_of_type * max_size_of_container)
 		 * @return max bits size
 		 */
-		[[nodiscard]] constexpr size_type max_size() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type max_size() const
 		noexcept(
 			noexcept(std::declval<container>().max_size()))
 		{
@@ -473,14 +597,14 @@ namespace gal::toolbox::container
 		 * @brief are we hold zero bits?
 		 * @return empty
 		 */
-		[[nodiscard]] constexpr bool empty() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool empty() const
 		noexcept(noexcept(std::declval<basic_dynamic_bitset>().size())) { return size() == 0; }
 
 		/**
 		 * @brief get the capacity of bits we hold (normally, bits_of_type * capacity_of_container)
 		 * @return what capacity is now
 		 */
-		[[nodiscard]] constexpr size_type capacity() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type capacity() const
 		noexcept(noexcept(std::declval<container>().capacity())) { return container_.capacity() * bits_of_type; }
 
 	private:
@@ -489,7 +613,7 @@ namespace gal::toolbox::container
 		 * @param pos bit's pos
 		 * @return it this bit set
 		 */
-		[[nodiscard]] constexpr bool unchecked_test(const size_type pos) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool unchecked_test(const size_type pos) const
 		noexcept(
 			noexcept(std::declval<container>()[0])) { return (container_[bit_trait::block_index(pos)] bitand bit_trait::bit_mask(pos)) not_eq 0; }
 
@@ -504,7 +628,7 @@ namespace gal::toolbox::container
 		 * @brief get the highest block in container (normally, the container.back() element)
 		 * @return highest block
 		 */
-		[[nodiscard]] GAL_ASSERT_CONSTEXPR real_reference highest_block() noexcept(noexcept(std::declval<container>().back()))
+		[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR real_reference highest_block() noexcept(noexcept(std::declval<container>().back()))
 		{
 			gal_assert(size() > 0 && container_size() > 0, "empty container");
 			return container_.back();
@@ -514,7 +638,7 @@ namespace gal::toolbox::container
 		 * @brief get the highest block in container (normally, the container.back() element)
 		 * @return highest block
 		 */
-		[[nodiscard]] GAL_ASSERT_CONSTEXPR real_const_reference highest_block() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR real_const_reference highest_block() const
 		noexcept(noexcept(std::declval<container>().back()))
 		{
 			gal_assert(size() > 0 && container_size() > 0, "empty container");
@@ -526,7 +650,7 @@ namespace gal::toolbox::container
 		 * @param size how many bits we want to hold
 		 * @param value the value for init
 		 */
-		GAL_ASSERT_CONSTEXPR void init_from_value_type(const size_type size,
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void init_from_value_type(const size_type size,
 		                                               value_type value) noexcept(
 			noexcept(std::declval<container>().resize(calc_blocks_needed(std::declval<size_type>()))))
 		{
@@ -542,15 +666,14 @@ namespace gal::toolbox::container
 			constexpr auto left_shifter = [](real_reference v) constexpr-> void
 			{
 				if constexpr (bits_of_type >= bits_of_unsigned_long) { v = 0; }
-				else { v = static_cast<value_type>(static_cast<decltype(bits_of_unsigned_long)>(v) >> bits_of_type); }
+				else { v = static_cast<value_type>(static_cast<size_type>(v) >> bits_of_type); }
 			};
 
-			for (auto it = container_.begin();; ++it)
+			// the blocks are already zero-initialized, stop at the first zero (or at the end, size may be 0)
+			for (auto it = container_.begin(); it not_eq container_.end() and value not_eq 0; ++it)
 			{
 				*it = value;
 				left_shifter(value);
-
-				if (value == 0) break;
 			}
 		}
 
@@ -565,7 +688,7 @@ namespace gal::toolbox::container
 		 * @param size how many bits we want(will) to hold, better make sure it greater than n
 		 */
 		template<typename Char, typename Traits, typename Allocator>
-		GAL_ASSERT_CONSTEXPR void init_from_basic_string(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void init_from_basic_string(
 				const std::basic_string<Char, Traits, Allocator>bitand str,
 				typename std::basic_string<Char, Traits, Allocator>::size_type pos,
 				typename std::basic_string<Char, Traits, Allocator>::size_type n,
@@ -610,7 +733,7 @@ namespace gal::toolbox::container
 		 * @param size how many bits we want(will) to hold, better make sure it greater than n
 		 */
 		template<typename Char, typename Traits>
-		GAL_ASSERT_CONSTEXPR void init_from_basic_string_view(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void init_from_basic_string_view(
 				const std::basic_string_view<Char, Traits> str,
 				typename std::basic_string_view<Char, Traits>::size_type pos,
 				typename std::basic_string_view<Char, Traits>::size_type n,
@@ -653,7 +776,7 @@ namespace gal::toolbox::container
 		 * @param full_block_operation range processor, process a full block
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& range_operation(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& range_operation(
 				const size_type pos,
 				const size_type len,
 				value_type (*partial_block_operation)(value_type, size_type, size_type),
@@ -717,7 +840,7 @@ namespace gal::toolbox::container
 		 * @brief count extra bits (in last block)
 		 * @return extra bits
 		 */
-		[[nodiscard]] constexpr size_type count_extra_bits() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type count_extra_bits() const
 		noexcept(
 			noexcept(bit_trait::bit_index(std::declval<basic_dynamic_bitset>().size()))) { return bit_trait::bit_index(size()); }
 
@@ -725,7 +848,7 @@ namespace gal::toolbox::container
 		 * @brief if size() is not a multiple of bits_per_block then not all the bits in the last block are used.
 		 * this function resets the unused bits (convenient for the implementation of many member functions)
 		 */
-		GAL_ASSERT_CONSTEXPR void zero_unused_bits() noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void zero_unused_bits() noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().highest_block()))
 		{
 			gal_assert(container_size() == calc_blocks_needed(total_), "used size not equal the needed size");
@@ -737,7 +860,7 @@ namespace gal::toolbox::container
 		 * @brief check class invariants
 		 * @return is invariant
 		 */
-		[[nodiscard]] constexpr bool check_invariants() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool check_invariants() const
 		noexcept(
 			noexcept(calc_blocks_needed(std::declval<size_type>())))
 		{
@@ -754,14 +877,14 @@ namespace gal::toolbox::container
 		/**
 		 * @brief default ctor
 		 */
-		constexpr basic_dynamic_bitset() noexcept(std::is_nothrow_default_constructible_v<container>) = default;
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset() noexcept(std::is_nothrow_default_constructible_v<container>) = default;
 
 		/**
 		 * @brief ctor from size, maybe need exchange the arg order of value and alloc
 		 * @param size how many bits we want(will) to hold
 		 * @param value the value to init
 		 */
-		GAL_ASSERT_CONSTEXPR explicit basic_dynamic_bitset(// NOLINT(clang-diagnostic-invalid-constexpr)
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR explicit basic_dynamic_bitset(// NOLINT(clang-diagnostic-invalid-constexpr)
 				const size_type size,
 				const value_type value = {}) noexcept(noexcept(init_from_value_type(std::declval<size_type>(), std::declval<value_type>()))) { init_from_value_type(size, value); }
 
@@ -776,7 +899,7 @@ namespace gal::toolbox::container
 		 * @param size container size we need (better make sure size >= n)
 		 */
 		template<typename Char, typename Traits = std::char_traits<Char>, typename Allocator = std::allocator<Char>>
-		constexpr basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset(
 				const std::basic_string<Char, Traits, Allocator>bitand str,
 				typename std::basic_string<Char, Traits, Allocator>::size_type pos,
 				typename std::basic_string<Char, Traits, Allocator>::size_type n,
@@ -801,7 +924,7 @@ namespace gal::toolbox::container
 		 * @param pos begin pos
 		 */
 		template<typename Char, typename Traits = std::char_traits<Char>, typename Allocator = std::allocator<Char>>
-		constexpr explicit basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR explicit basic_dynamic_bitset(
 				const std::basic_string<Char, Traits, Allocator>bitand str,
 				typename std::basic_string<Char, Traits, Allocator>::size_type pos = {}) noexcept(std::is_nothrow_constructible_v<basic_dynamic_bitset, decltype(str), decltype(pos), decltype(std::basic_string<Char, Traits, Allocator>::npos), decltype(npos)>)
 			: basic_dynamic_bitset(str, pos, std::basic_string<Char, Traits, Allocator>::npos, npos) { }
@@ -816,7 +939,7 @@ namespace gal::toolbox::container
 		 * @param size container size we need (better make sure size >= n)
 		 */
 		template<typename Char, typename Traits = std::char_traits<Char>>
-		constexpr basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset(
 				std::basic_string_view<Char, Traits> str,
 				typename std::basic_string_view<Char, Traits>::size_type pos,
 				typename std::basic_string_view<Char, Traits>::size_type n,
@@ -837,13 +960,13 @@ namespace gal::toolbox::container
 		 * @param pos begin pos
 		 */
 		template<typename Char, typename Traits = std::char_traits<Char>>
-		constexpr explicit basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR explicit basic_dynamic_bitset(
 				std::basic_string_view<Char, Traits> str,
 				typename std::basic_string_view<Char, Traits>::size_type pos = {}) noexcept(std::is_nothrow_constructible_v<basic_dynamic_bitset, decltype(str), decltype(pos), decltype(std::basic_string_view<Char, Traits>::npos), decltype(npos)>)
 			: basic_dynamic_bitset(str, pos, std::basic_string_view<Char, Traits>::npos, npos) { }
 
 		template<typename Char>
-		constexpr explicit basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR explicit basic_dynamic_bitset(
 				const Char* str,
 				size_type pos,
 				size_type n,
@@ -851,7 +974,7 @@ namespace gal::toolbox::container
 			: basic_dynamic_bitset(std::basic_string_view<Char>{str}, pos, n, size) { }
 
 		template<typename Char>
-		constexpr explicit basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR explicit basic_dynamic_bitset(
 				const Char* str,
 				size_type pos) noexcept(std::is_nothrow_constructible_v<basic_dynamic_bitset, decltype(str), decltype(pos), decltype(npos), decltype(npos)>)
 			: basic_dynamic_bitset(str, pos, npos, npos) { }
@@ -869,13 +992,13 @@ namespace gal::toolbox::container
 			         } and
 			         requires(container c)
 			         {
-				         c.insert(c.end(), ContainerInputIterator{}, ContainerInputIterator{});
+				         c.assign(ContainerInputIterator{}, ContainerInputIterator{});
 			         }
-		constexpr basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset(
 				ContainerInputIterator first,
-				ContainerInputIterator last) noexcept(noexcept(std::declval<container>().insert(std::declval<container>().begin(), first, last)))
+				ContainerInputIterator last) noexcept(noexcept(std::declval<container>().assign(first, last)))
 		{
-			container_.insert(container_.begin(), first, last);
+			container_.assign(first, last);
 			total_ += container_.size() * bits_of_type;
 		}
 
@@ -886,7 +1009,7 @@ namespace gal::toolbox::container
 		 * @param is basic_istream
 		 */
 		template<typename Char, typename Trait = std::char_traits<Char>>
-		constexpr explicit basic_dynamic_bitset(
+		GAL_DYNAMIC_BITSET_CONSTEXPR explicit basic_dynamic_bitset(
 				std::basic_istream<Char, Trait>bitand is) { is >> *this; }
 
 		/**
@@ -895,14 +1018,10 @@ namespace gal::toolbox::container
 		 */
 		template<typename T>
 			requires std::is_convertible_v<T, value_type>
-		constexpr basic_dynamic_bitset(std::initializer_list<T> args) noexcept(
-			std::is_nothrow_convertible_v<T, value_type> and noexcept(
-				std::declval<container>().insert(
-						std::declval<container>().begin(),
-						std::declval<value_type>())) and noexcept(std::declval<container>().push_back(std::declval<value_type>())))
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset(std::initializer_list<T> args) noexcept(
+			std::is_nothrow_convertible_v<T, value_type> and noexcept(std::declval<container>().assign(args.begin(), args.end())))
 		{
-			if constexpr (std::is_same_v<T, value_type>) { container_.insert(container_.begin(), args); }
-			else { for (auto it = args.begin(); it not_eq args.end(); ++it) { container_.push_back(static_cast<value_type>(*it)); } }
+			container_.assign(args.begin(), args.end());
 
 			total_ += container_.size() * bits_of_type;
 		}
@@ -910,26 +1029,26 @@ namespace gal::toolbox::container
 		/**
 		 * @brief dtor
 		 */
-		GAL_ASSERT_CONSTEXPR ~basic_dynamic_bitset() noexcept { gal_assert(check_invariants(), "dtor check_invariants failed"); }
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR ~basic_dynamic_bitset() noexcept { gal_assert(check_invariants(), "dtor check_invariants failed"); }
 
 		/**
 		 * @brief copy ctor
 		 * @param other another dynamic_bitset for copy
 		 */
-		constexpr basic_dynamic_bitset(const basic_dynamic_bitset& other) noexcept(std::is_nothrow_copy_constructible_v<container>) = default;
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset(const basic_dynamic_bitset& other) noexcept(std::is_nothrow_copy_constructible_v<container>) = default;
 
 		/**
 		 * @brief copy assign operator
 		 * @param other another dynamic_bitset for copy
 		 * @return self
 		 */
-		constexpr basic_dynamic_bitset& operator=(const basic_dynamic_bitset& other) noexcept(std::is_nothrow_copy_assignable_v<container>) = default;
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset& operator=(const basic_dynamic_bitset& other) noexcept(std::is_nothrow_copy_assignable_v<container>) = default;
 
 		/**
 		 * @brief move ctor
 		 * @param other another dynamic_bitset for move
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset(basic_dynamic_bitset&& other) noexcept(std::is_nothrow_move_constructible_v<container>)
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset(basic_dynamic_bitset&& other) noexcept(std::is_nothrow_move_constructible_v<container>)
 			: container_(std::move(other.container_)),
 			  total_(other.total_)
 		{
@@ -943,7 +1062,7 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset for move
 		 * @return self
 		 */
-		constexpr basic_dynamic_bitset& operator=(basic_dynamic_bitset&& other) noexcept(std::is_nothrow_move_assignable_v<container>)
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset& operator=(basic_dynamic_bitset&& other) noexcept(std::is_nothrow_move_assignable_v<container>)
 		{
 			if (std::addressof(other) == this) { return *this; }
 			container_ = std::move(other.container_);
@@ -954,11 +1073,35 @@ namespace gal::toolbox::container
 			return *this;
 		}
 
+		/**
+		 * @brief ctor from a lazy expression, evaluate it in one pass without any temporary bitset
+		 * @tparam Expression expression type
+		 * @param expression expression, e.g. (a & b) | (c & ~d)
+		 */
+		template<dynamic_bitset_expression Expression>
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset(const Expression& expression)// NOLINT(google-explicit-constructor)
+		{
+			evaluate(expression);
+		}
+
+		/**
+		 * @brief assign from a lazy expression, evaluate it in one pass without any temporary bitset
+		 * @tparam Expression expression type
+		 * @param expression expression, self can be one of its operands
+		 * @return self
+		 */
+		template<dynamic_bitset_expression Expression>
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset& operator=(const Expression& expression)
+		{
+			evaluate(expression);
+			return *this;
+		}
+
 		/**
 		 * @brief swap container and size
 		 * @param other another dynamic_bitset
 		 */
-		constexpr void swap(basic_dynamic_bitset& other)// NOLINT(clang-diagnostic-invalid-constexpr)
+		GAL_DYNAMIC_BITSET_CONSTEXPR void swap(basic_dynamic_bitset& other)// NOLINT(clang-diagnostic-invalid-constexpr)
 		noexcept(std::is_nothrow_swappable_v<container>)
 		{
 			using std::swap;
@@ -970,13 +1113,13 @@ namespace gal::toolbox::container
 		 * @brief reserve enough memory for use (normally, size / bits_of_type, or container_real_size)
 		 * @param size how many size we need reserve
 		 */
-		constexpr void reserve(const size_type size) noexcept(
+		GAL_DYNAMIC_BITSET_CONSTEXPR void reserve(const size_type size) noexcept(
 			noexcept(std::declval<container>().reserve(std::declval<size_type>()))) { container_.reserve(calc_blocks_needed(size)); }
 
 		/**
 		 * @brief shrink to fit (normally, make container shrink to fit)
 		 */
-		constexpr void shrink_to_fit() noexcept(
+		GAL_DYNAMIC_BITSET_CONSTEXPR void shrink_to_fit() noexcept(
 			// std::is_nothrow_swappable_v<container>
 			noexcept(std::declval<container>().shrink_to_fit()))
 		{
@@ -993,7 +1136,7 @@ namespace gal::toolbox::container
 		 * @param len length
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& reset(const size_type pos,
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& reset(const size_type pos,
 		                                                 const size_type len) noexcept(
 			noexcept(
 				std::declval<basic_dynamic_bitset>().range_operation(
@@ -1007,7 +1150,7 @@ namespace gal::toolbox::container
 		 * @param pos pos of bit
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& reset(const size_type pos) noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& reset(const size_type pos) noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(pos < total_, "given pos greater than the total bits");
@@ -1020,7 +1163,7 @@ namespace gal::toolbox::container
 		 * @brief reset all block's value
 		 * @return self
 		 */
-		constexpr basic_dynamic_bitset& reset() noexcept(
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset& reset() noexcept(
 			noexcept(std::declval<container>().begin()))
 		{
 			std::ranges::fill(container_, static_cast<value_type>(0));
@@ -1034,7 +1177,7 @@ namespace gal::toolbox::container
 		 * @param set set or reset
 		 * @return self
 		 */
-		constexpr basic_dynamic_bitset& set(const size_type pos, const size_type len, const bool set)
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& set(const size_type pos, const size_type len, const bool set)
 		{
 			if (set) { return range_operation(pos, len, bit_trait::set_block_partial, bit_trait::set_block_full); }
 			return range_operation(pos, len, bit_trait::reset_block_partial, bit_trait::reset_block_full);
@@ -1046,7 +1189,7 @@ namespace gal::toolbox::container
 		 * @param set set or reset
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& set(const size_type pos,
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& set(const size_type pos,
 		                                               const bool set = true) noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().reset(std::declval<size_type>())))
 		{
@@ -1061,7 +1204,7 @@ namespace gal::toolbox::container
 		 * @brief set all block's value
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& set() noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& set() noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().zero_unused_bits()))
 		{
 			std::ranges::fill(container_, ~static_cast<value_type>(0));
@@ -1075,7 +1218,7 @@ namespace gal::toolbox::container
 		 * @param len length
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& flip(const size_type pos,
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& flip(const size_type pos,
 		                                                const size_type len) noexcept(
 			noexcept(
 				std::declval<basic_dynamic_bitset>().range_operation(
@@ -1089,7 +1232,7 @@ namespace gal::toolbox::container
 		 * @param pos pos of bit
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& flip(const size_type pos) noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& flip(const size_type pos) noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(pos < total_, "given pos greater than the total bits");
@@ -1102,7 +1245,7 @@ namespace gal::toolbox::container
 		 * @brief flip all block's value
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& flip() noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& flip() noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().zero_unused_bits()))
 		{
 			std::ranges::for_each(container_, [](auto& value) { value = compl value; });
@@ -1115,7 +1258,7 @@ namespace gal::toolbox::container
 		 * @param pos pos of bit
 		 * @return result
 		 */
-		[[nodiscard]] GAL_ASSERT_CONSTEXPR bool test(const size_type pos) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bool test(const size_type pos) const
 		noexcept(noexcept(std::declval<basic_dynamic_bitset>().unchecked_test(std::declval<size_type>())))
 		{
 			gal_assert(pos < total_, "given pos greater than the total bits");
@@ -1128,7 +1271,7 @@ namespace gal::toolbox::container
 		 * @param value expect value
 		 * @return tested value
 		 */
-		[[nodiscard]] GAL_ASSERT_CONSTEXPR bool test_and_set(const size_type pos,
+		[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bool test_and_set(const size_type pos,
 		                                                     const bool value) noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().set(std::declval<size_type>(), std::declval<bool>())))
 		{
@@ -1141,7 +1284,7 @@ namespace gal::toolbox::container
 		 * @brief is all bit been set ?
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool all() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool all() const
 		noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
@@ -1163,7 +1306,7 @@ namespace gal::toolbox::container
 		 * @brief is any bit been set ?
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool any() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool any() const
 		noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
@@ -1175,18 +1318,21 @@ namespace gal::toolbox::container
 		 * @brief is none bit been set ?
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool none() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool none() const
 		noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().any())) { return not any(); }
 
 		/**
 		 * @brief count how many bit been set
 		 * @return result
+		 * @note at runtime, the blocks are counted by the popcnt instruction or (for long bitsets) by an AVX2/AVX-512 kernel
 		 */
-		[[nodiscard]] constexpr size_type count() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type count() const
 		noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().container_size()))
 		{
+			if (not details::is_constant_evaluated()) { return details::popcount(container_.data(), container_.size()); }
+
 			constexpr auto pop_count = [](value_type value) constexpr noexcept
 			{
 				static_assert(sizeof(std::byte) == sizeof(unsigned char));
@@ -1212,48 +1358,135 @@ namespace gal::toolbox::container
 				return num;
 			};
 
-			return std::accumulate(container_.begin(), container_.end(), size_type{0}, [](const auto& total, const auto& v) { return total + pop_count(v); });
+			size_type total{0};
+			for (const auto v: container_) { total += pop_count(v); }
+			return total;
+		}
+
+	private:
+		/**
+		 * @brief find the first set bit in the blocks [first_block, container_size)
+		 * @param first_block where to start
+		 * @return index of bit or npos
+		 */
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type find_from_block(const size_type first_block) const
+		noexcept(noexcept(std::declval<container>()[0]))
+		{
+			for (size_type i = first_block; i < container_size(); ++i)
+			{
+				if (container_[i] not_eq 0) { return i * bits_of_type + static_cast<size_type>(std::countr_zero(container_[i])); }
+			}
+			return npos;
+		}
+
+		/**
+		 * @brief find the last set bit in the blocks [0, last_block)
+		 * @param last_block where to stop (exclude)
+		 * @return index of bit or npos
+		 */
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type find_before_block(const size_type last_block) const
+		noexcept(noexcept(std::declval<container>()[0]))
+		{
+			for (size_type i = last_block; i-- > 0;)
+			{
+				if (container_[i] not_eq 0) { return i * bits_of_type + bits_of_type - 1 - static_cast<size_type>(std::countl_zero(container_[i])); }
+			}
+			return npos;
+		}
+
+	public:
+		/**
+		 * @brief find the first set bit
+		 * @return index of bit or npos (no bit set)
+		 */
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type find_first() const
+		noexcept(noexcept(std::declval<container>()[0])) { return find_from_block(0); }
+
+		/**
+		 * @brief find the first set bit after pos
+		 * @param pos where to start (exclude)
+		 * @return index of bit or npos (no bit set after pos)
+		 */
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type find_next(const size_type pos) const
+		noexcept(noexcept(std::declval<container>()[0]))
+		{
+			if (pos >= size() or pos + 1 == size()) { return npos; }
+
+			const auto next = pos + 1;
+			const auto block_index = bit_trait::block_index(next);
+			if (const auto block = container_[block_index] >> bit_trait::bit_index(next); block not_eq 0) { return next + static_cast<size_type>(std::countr_zero(block)); }
+			return find_from_block(block_index + 1);
+		}
+
+		/**
+		 * @brief find the last set bit
+		 * @return index of bit or npos (no bit set)
+		 */
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type find_last() const
+		noexcept(noexcept(std::declval<container>()[0])) { return find_before_block(container_size()); }
+
+		/**
+		 * @brief find the last set bit before pos
+		 * @param pos where to start (exclude), everything after size() is before pos
+		 * @return index of bit or npos (no bit set before pos)
+		 */
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR size_type find_prev(const size_type pos) const
+		noexcept(noexcept(std::declval<container>()[0]))
+		{
+			if (pos == 0 or empty()) { return npos; }
+
+			const auto prev = std::min(pos, size()) - 1;
+			const auto block_index = bit_trait::block_index(prev);
+			if (const auto block = container_[block_index] << (bits_of_type - 1 - bit_trait::bit_index(prev)); block not_eq 0) { return prev - static_cast<size_type>(std::countl_zero(block)); }
+			return find_before_block(block_index);
 		}
 
+		/**
+		 * @brief get a view of the indices of the set bits (in ascending order), much faster than testing every bit for a sparse bitset
+		 * @return view
+		 * @note the view is invalidated by anything that modifies the bitset
+		 */
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR std::ranges::subrange<set_bit_iterator, std::default_sentinel_t> set_bits() const noexcept { return {set_bit_iterator{*this}, std::default_sentinel}; }
+
 		/**
 		 * @brief get a bit ref
 		 * @param index index of bit
 		 * @return ref
 		 */
-		[[nodiscard]] constexpr reference operator[](const size_type index) noexcept(std::is_nothrow_constructible_v<reference, real_reference, size_type>) { return {container_[bit_trait::block_index(index)], bit_trait::bit_index(index)}; }
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR reference operator[](const size_type index) noexcept(std::is_nothrow_constructible_v<reference, real_reference, size_type>) { return {container_[bit_trait::block_index(index)], bit_trait::bit_index(index)}; }
 
 		/**
 		 * @brief get a bit ref
 		 * @param index index of bit
 		 * @return ref
 		 */
-		[[nodiscard]] constexpr const_reference operator[](const size_type index) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR const_reference operator[](const size_type index) const
 		noexcept(std::is_nothrow_constructible_v<reference, real_reference, size_type>) { return {container_[bit_trait::block_index(index)], bit_trait::bit_index(index)}; }
 
 		/**
 		 * @brief get a iterator in container.begin()
 		 * @return iterator
 		 */
-		[[nodiscard]] constexpr iterator begin() noexcept(std::is_nothrow_constructible_v<iterator, real_iterator, size_type>) { return {container_.begin(), 0}; }
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR iterator begin() noexcept(std::is_nothrow_constructible_v<iterator, real_iterator, size_type>) { return {container_.begin(), 0}; }
 
 		/**
 		 * @brief get a iterator in container.begin()
 		 * @return iterator
 		 */
-		[[nodiscard]] constexpr const_iterator begin() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR const_iterator begin() const
 		noexcept(std::is_nothrow_constructible_v<iterator, real_iterator, size_type>) { return {container_.begin(), 0}; }
 
 		/**
 		 * @brief get a iterator in container.end()
 		 * @return iterator
 		 */
-		[[nodiscard]] constexpr iterator end() noexcept(std::is_nothrow_constructible_v<iterator, real_iterator, size_type>) { return {container_.begin(), total_}; }
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR iterator end() noexcept(std::is_nothrow_constructible_v<iterator, real_iterator, size_type>) { return {container_.begin(), total_}; }
 
 		/**
 		 * @brief get a iterator in container.end()
 		 * @return iterator
 		 */
-		[[nodiscard]] constexpr const_iterator end() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR const_iterator end() const
 		noexcept(std::is_nothrow_constructible_v<iterator, real_iterator, size_type>) { return {container_.begin(), total_}; }
 
 		/**
@@ -1261,7 +1494,7 @@ namespace gal::toolbox::container
 		 * @param size required size
 		 * @param value value to set
 		 */
-		GAL_ASSERT_CONSTEXPR void resize(const size_type size, const bool value = false)
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void resize(const size_type size, const bool value = false)
 		{
 			const auto old_size = container_size();
 			const auto required_size = calc_blocks_needed(size);
@@ -1299,7 +1532,7 @@ namespace gal::toolbox::container
 		/**
 		 * @brief clear container
 		 */
-		constexpr void clear() noexcept(noexcept(std::declval<container>().clear()))
+		GAL_DYNAMIC_BITSET_CONSTEXPR void clear() noexcept(noexcept(std::declval<container>().clear()))
 		{
 			container_.clear();
 			total_ = 0;
@@ -1309,13 +1542,13 @@ namespace gal::toolbox::container
 		 * @brief push a bit from back
 		 * @param value bit's value
 		 */
-		GAL_ASSERT_CONSTEXPR void push_back(const bool value) noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void push_back(const bool value) noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().resize(std::declval<size_type>(), std::declval<bool>()))) { resize(size() + 1, value); }
 
 		/**
 		 * @brief pop a bit from back
 		 */
-		GAL_ASSERT_CONSTEXPR void pop_back() noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void pop_back() noexcept(
 			noexcept(zero_unused_bits()))
 		{
 			const auto old_size = container_size();
@@ -1329,7 +1562,7 @@ namespace gal::toolbox::container
 		 * @brief append a value (not a bit) from back (it means you will append bits_of_type bits from back)
 		 * @param value value for append
 		 */
-		GAL_ASSERT_CONSTEXPR void append(const value_type value)
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR void append(const value_type value)
 		{
 			if (const auto extra = count_extra_bits(); extra == 0)
 			{
@@ -1347,13 +1580,39 @@ namespace gal::toolbox::container
 		}
 
 	private:
-		template<typename Function>
-		constexpr void operator_invoker(Function&& function, const basic_dynamic_bitset& other) noexcept
+		template<dynamic_bitset_expression Expression>
+		GAL_DYNAMIC_BITSET_CONSTEXPR void evaluate(const Expression& expression)
+		{
+			if (size() == expression.size())
+			{
+				// block i only reads block i of the operands, so self can be one of the operands
+				for (size_type i = 0; i < container_size(); ++i) { container_[i] = expression.block(i); }
+			}
+			else
+			{
+				// self may be one of the operands, do not touch it until the expression is evaluated
+				container blocks(calc_blocks_needed(expression.size()));
+				for (size_type i = 0; i < blocks.size(); ++i) { blocks[i] = expression.block(i); }
+				container_ = std::move(blocks);
+				total_ = expression.size();
+			}
+
+			// compl sets the unused bits
+			zero_unused_bits();
+			gal_assert(check_invariants(), "check_invariants failed");
+		}
+
+		template<details::block_operation Operation>
+		GAL_DYNAMIC_BITSET_CONSTEXPR void operator_invoker(const basic_dynamic_bitset& other) noexcept
 		{
-			functional::zip_invoke(
-					std::forward<Function>(function),
-					container_,
-					other.container_.begin());
+			if (details::is_constant_evaluated())
+			{
+				functional::zip_invoke(
+						[](auto& lhs, const auto& rhs) { lhs = details::apply<Operation>(lhs, rhs); },
+						container_,
+						other.container_.begin());
+			}
+			else { details::transform<Operation>(container_.data(), other.container_.data(), container_size()); }
 		}
 
 	public:
@@ -1362,13 +1621,12 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& operator and_eq(const basic_dynamic_bitset& other) noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& operator and_eq(const basic_dynamic_bitset& other) noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(size() == other.size(), "the two containers are not the same size");
 
-			operator_invoker([](auto& lhs, const auto& rhs) { lhs and_eq rhs; },
-			                 other);
+			operator_invoker<details::block_operation::bit_and>(other);
 
 			return *this;
 		}
@@ -1378,13 +1636,12 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& operator or_eq(const basic_dynamic_bitset& other) noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& operator or_eq(const basic_dynamic_bitset& other) noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(size() == other.size(), "the two containers are not the same size");
 
-			operator_invoker([](auto& lhs, const auto& rhs) { lhs or_eq rhs; },
-			                 other);
+			operator_invoker<details::block_operation::bit_or>(other);
 
 			return *this;
 		}
@@ -1394,13 +1651,12 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& operator xor_eq(const basic_dynamic_bitset& other) noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& operator xor_eq(const basic_dynamic_bitset& other) noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(size() == other.size(), "the two containers are not the same size");
 
-			operator_invoker([](auto& lhs, const auto& rhs) { lhs xor_eq rhs; },
-			                 other);
+			operator_invoker<details::block_operation::bit_xor>(other);
 
 			return *this;
 		}
@@ -1410,77 +1666,49 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return self
 		 */
-		GAL_ASSERT_CONSTEXPR basic_dynamic_bitset& operator-=(const basic_dynamic_bitset& other) noexcept(
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& operator-=(const basic_dynamic_bitset& other) noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(size() == other.size(), "the two containers are not the same size");
 
-			operator_invoker([](auto& lhs, const auto& rhs) { lhs and_eq compl rhs; },
-			                 other);
+			operator_invoker<details::block_operation::bit_and_not>(other);
 
 			return *this;
 		}
 
+	private:
 		/**
-		 * @brief left shift self
+		 * @brief dst[i] = (src << n)[i] | merge[i] (no merge if not Merge), see details::shift_left
+		 */
+		template<bool Merge>
+		constexpr static void shift_left_blocks(value_type* dst, const size_type dst_size, const value_type* src, const size_type src_size, const size_type n, const value_type* merge = nullptr) noexcept
+		{
+			if (details::is_constant_evaluated()) { details::shift_left_scalar<Merge>(dst, dst_size, src, src_size, n, merge); }
+			else { details::shift_left<Merge>(dst, dst_size, src, src_size, n, merge); }
+		}
+
+		/**
+		 * @brief dst[i] = (src >> n)[i] | merge[i] (no merge if not Merge), see details::shift_right
+		 */
+		template<bool Merge>
+		constexpr static void shift_right_blocks(value_type* dst, const size_type dst_size, const value_type* src, const size_type src_size, const size_type n, const value_type* merge = nullptr) noexcept
+		{
+			if (details::is_constant_evaluated()) { details::shift_right_scalar<Merge>(dst, dst_size, src, src_size, n, merge); }
+			else { details::shift_right<Merge>(dst, dst_size, src, src_size, n, merge); }
+		}
+
+	public:
+		/**
+		 * @brief left shift self (every bit moves to a higher index), in place
 		 * @param n offset
 		 * @return self
 		 */
-		constexpr basic_dynamic_bitset& operator<<=(const size_type n) noexcept(
-			noexcept(std::declval<container>()[0]))
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset& operator<<=(const size_type n) noexcept(
+			noexcept(std::declval<basic_dynamic_bitset>().reset()))
 		{
 			if (n >= total_) { return reset(); }
 
-			// note that we store every bit from back to front, it means left shift actually is right shift
-			// from blocks_need_discard to total_blocks is the part we need save
-			// or container[blocks_need_discard : total_blocks]
-			const auto total_blocks = container_size() - 1;
-			const auto blocks_need_discard = bit_trait::block_index(n);
-
-			if (const auto remained_bits = bit_trait::bit_index(n); remained_bits == 0)
-			{
-				// it is full fit a block
-				// copy remained part which we needed
-				std::ranges::copy_n(
-						container_.begin(),
-						static_cast<container::difference_type>(total_blocks - blocks_need_discard + 1),
-						container_.begin() + static_cast<container::difference_type>(blocks_need_discard));
-			}
-			else
-			{
-				// more work we need to do
-				/*
-				 *      remained_bits
-				 *  |***|
-				 *  |***********************************|
-				 *      |******************************|
-				 *      extra_bits_in_block
-				 *
-				 * actually, we save extra_bits_in_block part (container[0] << remained_bits) in last block (container[blocks_need_discard])
-				 * and remained_bits part (container[i] >> extra_bits_in_block) | extra_bits_in_block part (container[i - 1] << remained_bits) in other block
-				 */
-
-				const auto extra_bits_in_block = bits_of_type - remained_bits;
-
-				functional::zip_invoke(
-						[extra_bits_in_block, remained_bits](auto& v, const auto& extra, const auto& remained)
-						{
-							// store this block's remained_bits part and last (actually, is next block, but we store every bit from back to front) block's extra_bits_in_block part
-							v = (extra >> extra_bits_in_block) bitor (remained << remained_bits);
-						},
-						container_.begin() + 1 + static_cast<container::difference_type>(blocks_need_discard),
-						container_.begin() + 1 + static_cast<container::difference_type>(blocks_need_discard + total_blocks - blocks_need_discard),
-						container_.begin(),
-						container_.begin() + 1);
-
-				container_[blocks_need_discard] = container_[0] << remained_bits;
-			}
-
-			// zero out front part
-			std::ranges::fill_n(
-					container_.begin(),
-					static_cast<container::difference_type>(blocks_need_discard),
-					value_type{0});
+			shift_left_blocks<false>(container_.data(), container_size(), container_.data(), container_size(), n);
 			// zero out any 1 bit that flowed into the unused part
 			zero_unused_bits();
 
@@ -1488,64 +1716,84 @@ namespace gal::toolbox::container
 		}
 
 		/**
-		 * @brief right shift self
+		 * @brief right shift self (every bit moves to a lower index), in place
 		 * @param n offset
 		 * @return self
 		 */
-		constexpr basic_dynamic_bitset& operator>>=(const size_type n) noexcept(
-			noexcept(std::declval<container>()[0]))
+		GAL_DYNAMIC_BITSET_CONSTEXPR basic_dynamic_bitset& operator>>=(const size_type n) noexcept(
+			noexcept(std::declval<basic_dynamic_bitset>().reset()))
 		{
 			if (n >= total_) { return reset(); }
 
-			// note that we store every bit from back to front, it means right shift actually is left shift
-			// from 0 to blocks_need_discard is the part we need save
-			// or container[0 : blocks_need_discard]
-			const auto total_blocks = container_size() - 1;
-			const auto blocks_need_discard = bit_trait::block_index(n);
+			// the unused part is always 0, so nothing flows into the used part
+			shift_right_blocks<false>(container_.data(), container_size(), container_.data(), container_size(), n);
 
-			if (const auto remained_bits = bit_trait::bit_index(n); remained_bits == 0)
-			{
-				// it is full fit a block
-				// copy remained part which we needed
-				std::ranges::copy_n(
-						container_.begin() + static_cast<container::difference_type>(blocks_need_discard),
-						static_cast<container::difference_type>(total_blocks - blocks_need_discard + 1),
-						container_.begin());
-			}
-			else
-			{
-				// more work we need to do
-				/*
-				 *      extra_bits_in_block
-				 *  |***|
-				 *  |***********************************|
-				 *      |******************************|
-				 *      remained_bits
-				 *
-				 * actually, we save extra_bits_in_block part (container[total_blocks] >> remained_bits) in first block (container[total_blocks - blocks_need_discard])
-				 * and remained_bits part (container[i + 1] << extra_bits_in_block) | extra_bits_in_block part (container[i] >> remained_bits) in other block
-				 */
-				const auto extra_bits_in_block = bits_of_type - bit_trait::bit_index(n);
+			return *this;
+		}
 
-				functional::zip_invoke(
-						[extra_bits_in_block, remained_bits](auto& v, const auto& extra, const auto& remained)
-						{
-							// store this block's remained_bits part and next (actually, is last block, but we store every bit from back to front) block's extra_bits_in_block part
-							v = (extra >> extra_bits_in_block) bitor (remained << remained_bits);
-						},
-						container_.begin(),
-						container_.begin() + static_cast<container::difference_type>(total_blocks - blocks_need_discard),
-						container_.begin() + 1 + static_cast<container::difference_type>(blocks_need_discard),
-						container_.begin() + static_cast<container::difference_type>(blocks_need_discard));
-
-				container_[total_blocks - blocks_need_discard] = container_[total_blocks] >> remained_bits;
-			}
+		/**
+		 * @brief rotate self left (every bit moves to a higher index, the highest n bits move to the lowest)
+		 * @param n offset (can be greater than size())
+		 * @return self
+		 * @note only the smaller one of the two parts is copied
+		 */
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& rotate_left(size_type n)
+		{
+			if (empty()) { return *this; }
+
+			n %= size();
+			if (n == 0) { return *this; }
+			if (n > size() / 2) { return rotate_right(size() - n); }
 
-			// zero out back part
-			std::ranges::fill_n(
-					container_.begin() + static_cast<container::difference_type>(total_blocks - blocks_need_discard),
-					static_cast<container::difference_type>(blocks_need_discard),
-					value_type{0});
+			// the highest n bits
+			container wrapped(calc_blocks_needed(n));
+			shift_right_blocks<false>(wrapped.data(), wrapped.size(), container_.data(), container_size(), size() - n);
+
+			shift_left_blocks<false>(container_.data(), container_size(), container_.data(), container_size(), n);
+			for (size_type i = 0; i < wrapped.size(); ++i) { container_[i] or_eq wrapped[i]; }
+			zero_unused_bits();
+
+			return *this;
+		}
+
+		/**
+		 * @brief rotate self right (every bit moves to a lower index, the lowest n bits move to the highest)
+		 * @param n offset (can be greater than size())
+		 * @return self
+		 * @note only the smaller one of the two parts is copied
+		 */
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& rotate_right(size_type n)
+		{
+			if (empty()) { return *this; }
+
+			n %= size();
+			if (n == 0) { return *this; }
+			if (n > size() / 2) { return rotate_left(size() - n); }
+
+			// the lowest n bits
+			container wrapped(container_.begin(), container_.begin() + static_cast<container::difference_type>(calc_blocks_needed(n)));
+			if (const auto extra_bits = bit_trait::bit_index(n); extra_bits not_eq 0) { wrapped.back() and_eq (value_type{1} << extra_bits) - 1; }
+
+			shift_right_blocks<false>(container_.data(), container_size(), container_.data(), container_size(), n);
+			shift_left_blocks<true>(container_.data(), container_size(), wrapped.data(), wrapped.size(), size() - n, container_.data());
+			zero_unused_bits();
+
+			return *this;
+		}
+
+		/**
+		 * @brief self = (self << n) | other in one pass, in place (e.g. slide a window and add the new bits)
+		 * @param other another dynamic_bitset (can be self)
+		 * @param n offset
+		 * @return self
+		 */
+		GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR basic_dynamic_bitset& shift_and_or(const basic_dynamic_bitset& other, const size_type n) noexcept
+		{
+			gal_assert(size() == other.size(), "the two containers are not the same size");
+
+			// self << n is 0 if n >= size(), the kernel handles it
+			shift_left_blocks<true>(container_.data(), container_size(), container_.data(), container_size(), n, other.container_.data());
+			zero_unused_bits();
 
 			return *this;
 		}
@@ -1576,24 +1824,12 @@ namespace gal::toolbox::container
 			return copy;
 		}
 
-		/**
-		 * @brief flip a copy all bit
-		 * @return copy
-		 */
-		[[nodiscard]] basic_dynamic_bitset operator compl() const
-		noexcept(noexcept(std::declval<basic_dynamic_bitset>().flip()))
-		{
-			auto copy{*this};
-			copy.flip();
-			return copy;
-		}
-
 		/**
 		 * @brief is the same dynamic_bitset ?
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool operator==(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator==(const basic_dynamic_bitset& other) const
 		noexcept { return total_ == other.total_ and container_ == other.container_; }
 
 		/**
@@ -1601,14 +1837,14 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool operator not_eq(const basic_dynamic_bitset& other) const noexcept { return not operator==(other); }
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator not_eq(const basic_dynamic_bitset& other) const noexcept { return not operator==(other); }
 
 		/**
 		 * @brief ss self less than another dynamic_bitset ?
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool operator<(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator<(const basic_dynamic_bitset& other) const
 		noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
@@ -1641,7 +1877,7 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool operator<=(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator<=(const basic_dynamic_bitset& other) const
 		noexcept(
 			noexcept(std::declval<basic_dynamic_bitset>().operator<(std::declval<const basic_dynamic_bitset&>()))) { return this->operator==(other) or this->operator<(other); }
 
@@ -1650,7 +1886,7 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool operator>(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator>(const basic_dynamic_bitset& other) const
 		noexcept(noexcept(std::declval<basic_dynamic_bitset>().operator<=(std::declval<const basic_dynamic_bitset&>()))) { return not this->operator<=(other); }
 
 		/**
@@ -1658,7 +1894,7 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool operator>=(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool operator>=(const basic_dynamic_bitset& other) const
 		noexcept(noexcept(std::declval<basic_dynamic_bitset>().operator<(std::declval<const basic_dynamic_bitset&>()))) { return not this->operator<(other); }
 
 		/**
@@ -1671,7 +1907,7 @@ namespace gal::toolbox::container
 		 * @return str
 		*/
 		template<typename Char = char, typename Trait = std::char_traits<Char>, typename Alloc = std::allocator<Char>>
-		[[nodiscard]] constexpr std::basic_string<Char, Trait, Alloc> to_string(
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR std::basic_string<Char, Trait, Alloc> to_string(
 				Char zero = static_cast<Char>('0'),
 				Char one = static_cast<Char>('1')) const
 		{
@@ -1694,7 +1930,7 @@ namespace gal::toolbox::container
 		 */
 		template<std::integral To = value_type>
 		// requires(sizeof(To) >= sizeof(value_type))
-		[[nodiscard]] GAL_ASSERT_CONSTEXPR To cast_to() const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR To cast_to() const
 		noexcept(
 			noexcept(bit_trait::block_index(std::declval<size_type>())))
 		{
@@ -1714,17 +1950,369 @@ namespace gal::toolbox::container
 			return result;
 		}
 
+	private:
+		constexpr static size_type serialize_header_size = sizeof(std::uint64_t) + sizeof(dynamic_bitset_encoding);
+		// how many blocks we encode/decode at once when streaming
+		constexpr static size_type serialize_chunk_blocks = 256;
+
+		/**
+		 * @brief count the runs of equal neighbouring blocks
+		 */
+		[[nodiscard]] size_type count_runs() const noexcept
+		{
+			size_type runs = 0;
+			for (size_type i = 0; i < container_size(); ++i) { if (i == 0 or container_[i] not_eq container_[i - 1]) { ++runs; } }
+			return runs;
+		}
+
+		/**
+		 * @brief serialize the bitset piece by piece
+		 * @param writer void(const void* data, size_type bytes), called for every piece in order
+		 * @param encoding how the blocks are stored
+		 */
+		template<typename Writer>
+		void serialize_to(Writer writer, const dynamic_bitset_encoding encoding) const
+		{
+			std::array<value_type, serialize_chunk_blocks> chunk;
+
+			chunk[0] = details::to_little_endian(size());
+			auto* header = reinterpret_cast<std::byte*>(chunk.data());
+			header[sizeof(std::uint64_t)] = static_cast<std::byte>(encoding);
+			writer(header, serialize_header_size);
+
+			if (encoding == dynamic_bitset_encoding::raw)
+			{
+				if constexpr (std::endian::native == std::endian::little)
+				{
+					// already in the right byte order, no copy at all
+					if (container_size() not_eq 0) { writer(container_.data(), container_size() * sizeof(value_type)); }
+				}
+				else
+				{
+					for (size_type i = 0; i < container_size(); i += chunk.size())
+					{
+						const auto blocks = std::min(chunk.size(), container_size() - i);
+						std::ranges::transform(container_.begin() + i, container_.begin() + i + blocks, chunk.begin(), details::to_little_endian);
+						writer(chunk.data(), blocks * sizeof(value_type));
+					}
+				}
+			}
+			else
+			{
+				size_type used = 0;
+				for (size_type i = 0; i < container_size();)
+				{
+					auto next = i + 1;
+					while (next < container_size() and container_[next] == container_[i]) { ++next; }
+
+					chunk[used++] = details::to_little_endian(container_[i]);
+					chunk[used++] = details::to_little_endian(next - i);
+					if (used == chunk.size())
+					{
+						writer(chunk.data(), used * sizeof(value_type));
+						used = 0;
+					}
+					i = next;
+				}
+				if (used not_eq 0) { writer(chunk.data(), used * sizeof(value_type)); }
+			}
+		}
+
+		/**
+		 * @brief check that the runs of a run-length encoded buffer add up to the blocks, without allocating anything
+		 * @param runs the bytes after the header
+		 * @param blocks how many blocks the header claims
+		 * @return is valid
+		 */
+		[[nodiscard]] static bool check_runs(const std::span<const std::byte> runs, const size_type blocks) noexcept
+		{
+			size_type offset = 0;
+			for (size_type i = 0; i < blocks;)
+			{
+				if (runs.size() - offset < 2 * sizeof(value_type)) { return false; }
+
+				value_type count;
+				std::memcpy(&count, runs.data() + offset + sizeof(value_type), sizeof(value_type));
+				count = details::to_little_endian(count);
+				if (count == 0 or count > blocks - i) { return false; }
+
+				i += count;
+				offset += 2 * sizeof(value_type);
+			}
+			return true;
+		}
+
+		/**
+		 * @brief deserialize a bitset piece by piece
+		 * @param reader bool(void* data, size_type bytes), read the next bytes, return false if there are not enough bytes
+		 * @param validate bool(size_type size, dynamic_bitset_encoding encoding), reject a corrupted header before decoding
+		 * @return bitset, or nullopt if the data is corrupted
+		 * @note the header is not trusted, the blocks grow as they are decoded instead of being allocated up front
+		 */
+		template<typename Reader, typename Validator>
+		[[nodiscard]] static std::optional<basic_dynamic_bitset> deserialize_from(Reader reader, Validator validate)
+		{
+			std::array<value_type, serialize_chunk_blocks> chunk;
+
+			auto* header = reinterpret_cast<std::byte*>(chunk.data());
+			if (not reader(header, serialize_header_size)) { return std::nullopt; }
+			const auto size = details::to_little_endian(chunk[0]);
+			const auto encoding = static_cast<dynamic_bitset_encoding>(header[sizeof(std::uint64_t)]);
+			if (encoding not_eq dynamic_bitset_encoding::raw and encoding not_eq dynamic_bitset_encoding::run_length) { return std::nullopt; }
+			if (not validate(size, encoding)) { return std::nullopt; }
+
+			const auto needed = calc_blocks_needed(size);
+			container blocks;
+
+			if (encoding == dynamic_bitset_encoding::raw)
+			{
+				while (blocks.size() < needed)
+				{
+					// read at least a chunk, at most as much as we already have (so we never allocate more than twice what the source really holds)
+					const auto old_size = blocks.size();
+					const auto count = std::min(needed - old_size, std::max(serialize_chunk_blocks, old_size));
+					blocks.resize(old_size + count);
+					if (not reader(blocks.data() + old_size, count * sizeof(value_type))) { return std::nullopt; }
+				}
+				if constexpr (std::endian::native not_eq std::endian::little) { std::ranges::transform(blocks, blocks.begin(), details::to_little_endian); }
+			}
+			else
+			{
+				while (blocks.size() < needed)
+				{
+					if (not reader(chunk.data(), 2 * sizeof(value_type))) { return std::nullopt; }
+					const auto block = details::to_little_endian(chunk[0]);
+					const auto count = details::to_little_endian(chunk[1]);
+					if (count == 0 or count > needed - blocks.size()) { return std::nullopt; }
+
+					blocks.resize(blocks.size() + count, block);
+				}
+			}
+
+			// the bits past size() are always 0
+			if (const auto extra = bit_trait::bit_index(size); extra not_eq 0 and (blocks.back() >> extra) not_eq 0) { return std::nullopt; }
+
+			basic_dynamic_bitset bitset;
+			bitset.container_ = std::move(blocks);
+			bitset.total_ = size;
+			return bitset;
+		}
+
+		/**
+		 * @brief encode the bitset to hex piece by piece
+		 * @param writer void(const char* data, size_type size), called for every piece in order
+		 */
+		template<typename Writer>
+		void to_hex_to(Writer writer) const
+		{
+			if (empty()) { return; }
+
+			std::array<char, serialize_chunk_blocks * 16> chunk;
+
+			// the highest block only has the digits we need
+			const auto top = container_size() - 1;
+			details::hex_encode_scalar(container_.data() + top, 1, chunk.data());
+			const auto top_digits = (size() - top * bits_of_type + 3) / 4;
+			writer(chunk.data() + 16 - top_digits, top_digits);
+
+			for (size_type end = top; end not_eq 0;)
+			{
+				const auto blocks = std::min(serialize_chunk_blocks, end);
+				details::hex_encode(container_.data() + end - blocks, blocks, chunk.data());
+				writer(chunk.data(), blocks * 16);
+				end -= blocks;
+			}
+		}
+
+	public:
+		/**
+		 * @brief get how many bytes serialize writes
+		 * @param encoding how the blocks are stored
+		 * @return bytes
+		 */
+		[[nodiscard]] size_type serialized_size(const dynamic_bitset_encoding encoding = dynamic_bitset_encoding::raw) const noexcept
+		{
+			const auto blocks = encoding == dynamic_bitset_encoding::raw ? container_size() : 2 * count_runs();
+			return serialize_header_size + blocks * sizeof(value_type);
+		}
+
+		/**
+		 * @brief serialize the bitset into a buffer (e.g. a memory-mapped file)
+		 * @param buffer buffer, at least serialized_size(encoding) bytes
+		 * @param encoding how the blocks are stored
+		 * @return how many bytes are written
+		 * @note the format is the bit count (8 bytes, little endian), the encoding (1 byte), then the blocks (little endian)
+		 */
+		size_type serialize(const std::span<std::byte> buffer, const dynamic_bitset_encoding encoding = dynamic_bitset_encoding::raw) const noexcept
+		{
+			gal_assert(buffer.size() >= serialized_size(encoding), "buffer too small");
+
+			size_type offset = 0;
+			serialize_to(
+					[buffer, &offset](const void* data, const size_type bytes)
+					{
+						std::memcpy(buffer.data() + offset, data, bytes);
+						offset += bytes;
+					},
+					encoding);
+			return offset;
+		}
+
+		/**
+		 * @brief serialize the bitset into a stream (opened in binary mode), without an intermediate buffer of the whole bitset
+		 * @param os stream
+		 * @param encoding how the blocks are stored
+		 * @return os
+		 */
+		std::ostream& serialize(std::ostream& os, const dynamic_bitset_encoding encoding = dynamic_bitset_encoding::raw) const
+		{
+			serialize_to([&os](const void* data, const size_type bytes) { os.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes)); }, encoding);
+			return os;
+		}
+
+		/**
+		 * @brief deserialize a bitset written by serialize
+		 * @param buffer buffer (e.g. a memory-mapped file)
+		 * @param read how many bytes are read (if not nullptr)
+		 * @return bitset, or nullopt if the data is corrupted or truncated
+		 */
+		[[nodiscard]] static std::optional<basic_dynamic_bitset> deserialize(const std::span<const std::byte> buffer, size_type* read = nullptr)
+		{
+			size_type offset = 0;
+			auto bitset = deserialize_from(
+					[buffer, &offset](void* data, const size_type bytes)
+					{
+						if (buffer.size() - offset < bytes) { return false; }
+						std::memcpy(data, buffer.data() + offset, bytes);
+						offset += bytes;
+						return true;
+					},
+					[buffer](const size_type size, const dynamic_bitset_encoding encoding)
+					{
+						const auto payload = buffer.subspan(serialize_header_size);
+						if (encoding == dynamic_bitset_encoding::raw) { return calc_blocks_needed(size) <= payload.size() / sizeof(value_type); }
+						return check_runs(payload, calc_blocks_needed(size));
+					});
+			if (read) { *read = offset; }
+			return bitset;
+		}
+
+		/**
+		 * @brief deserialize a bitset written by serialize from a stream (opened in binary mode)
+		 * @param is stream, failbit is set if the data is corrupted or truncated
+		 * @return bitset, or nullopt if the data is corrupted or truncated
+		 */
+		[[nodiscard]] static std::optional<basic_dynamic_bitset> deserialize(std::istream& is)
+		{
+			auto bitset = deserialize_from(
+					[&is](void* data, const size_type bytes) { return static_cast<bool>(is.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes))); },
+					[](const size_type, const dynamic_bitset_encoding) { return true; });
+			if (not bitset) { is.setstate(std::ios_base::failbit); }
+			return bitset;
+		}
+
+		/**
+		 * @brief get how many hex digits to_hex writes
+		 * @return (size() + 3) / 4
+		 */
+		[[nodiscard]] size_type hex_size() const noexcept { return (size() + 3) / 4; }
+
+		/**
+		 * @brief cast self to a hex string, the highest digit first (the same order as to_string, but 4 bits per char)
+		 * @return str
+		 */
+		[[nodiscard]] std::string to_hex() const
+		{
+			std::string str(hex_size(), '0');
+			to_hex(std::span{str});
+			return str;
+		}
+
+		/**
+		 * @brief write the hex digits into a buffer (e.g. a memory-mapped file)
+		 * @param buffer buffer, at least hex_size() chars
+		 * @return how many chars are written
+		 */
+		size_type to_hex(const std::span<char> buffer) const noexcept
+		{
+			gal_assert(buffer.size() >= hex_size(), "buffer too small");
+
+			size_type offset = 0;
+			to_hex_to(
+					[buffer, &offset](const char* data, const size_type size)
+					{
+						std::memcpy(buffer.data() + offset, data, size);
+						offset += size;
+					});
+			return offset;
+		}
+
+		/**
+		 * @brief write the hex digits into a stream, without an intermediate string of the whole bitset
+		 * @param os stream
+		 * @return os
+		 */
+		std::ostream& to_hex(std::ostream& os) const
+		{
+			to_hex_to([&os](const char* data, const size_type size) { os.write(data, static_cast<std::streamsize>(size)); });
+			return os;
+		}
+
+		/**
+		 * @brief construct a bitset from the hex digits written by to_hex (0-9, a-f, A-F, the highest digit first)
+		 * @param hex hex digits
+		 * @param size how many bits the bitset holds, in [hex.size() * 4 - 3, hex.size() * 4]
+		 * @return bitset, or nullopt if there is an invalid digit, or a set bit past size
+		 */
+		[[nodiscard]] static std::optional<basic_dynamic_bitset> from_hex(const std::string_view hex, const size_type size)
+		{
+			if (size > hex.size() * 4 or size + 3 < hex.size() * 4) { return std::nullopt; }
+
+			if (size == 0) { return basic_dynamic_bitset{}; }
+
+			// decode into our own blocks, the bitset only takes them once they are valid
+			container blocks(calc_blocks_needed(size));
+			const auto top = blocks.size() - 1;
+			const auto top_digits = hex.size() - top * 16;
+
+			// the highest block only has the digits we need
+			std::array<char, 16> top_block;
+			top_block.fill('0');
+			std::ranges::copy(hex.substr(0, top_digits), top_block.end() - static_cast<std::ptrdiff_t>(top_digits));
+			if (not details::hex_decode_scalar(top_block.data(), 1, blocks.data() + top) or
+			    not details::hex_decode(hex.data() + top_digits, top, blocks.data()))
+			{
+				return std::nullopt;
+			}
+
+			if (const auto extra = bit_trait::bit_index(size); extra not_eq 0 and (blocks.back() >> extra) not_eq 0) { return std::nullopt; }
+
+			basic_dynamic_bitset bitset;
+			bitset.container_ = std::move(blocks);
+			bitset.total_ = size;
+			return bitset;
+		}
+
+		/**
+		 * @brief construct a bitset from the hex digits written by to_hex (0-9, a-f, A-F, the highest digit first)
+		 * @param hex hex digits
+		 * @return bitset of hex.size() * 4 bits, or nullopt if there is an invalid digit
+		 */
+		[[nodiscard]] static std::optional<basic_dynamic_bitset> from_hex(const std::string_view hex) { return from_hex(hex, hex.size() * 4); }
+
 		/**
 		 * @brief is self is a subset of other ? (all set bits of self also set in other, but `maybe` other has set more bits)
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] GAL_ASSERT_CONSTEXPR bool is_subset_of(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bool is_subset_of(const basic_dynamic_bitset& other) const
 		noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(size() == other.size(), "the two containers are not the same size");
 
+			if (not details::is_constant_evaluated()) { return not details::any<details::block_operation::bit_and_not>(container_.data(), other.container_.data(), container_size()); }
+
 			for (size_type i = 0; i < container_size(); ++i) { if (container_[i] bitand compl other.container_[i]) { return false; } }
 			return true;
 		}
@@ -1734,12 +2322,19 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] GAL_ASSERT_CONSTEXPR bool is_proper_subset_of(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_ASSERT_CONSTEXPR bool is_proper_subset_of(const basic_dynamic_bitset& other) const
 		noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			gal_assert(size() == other.size(), "the two containers are not the same size");
 
+			if (not details::is_constant_evaluated())
+			{
+				// both passes stop at the first vector that decides the result
+				return not details::any<details::block_operation::bit_and_not>(container_.data(), other.container_.data(), container_size()) and
+				       details::any<details::block_operation::bit_and_not>(other.container_.data(), container_.data(), container_size());
+			}
+
 			bool proper = false;
 			for (size_type i = 0; i < container_size(); ++i)
 			{
@@ -1761,12 +2356,14 @@ namespace gal::toolbox::container
 		 * @param other another dynamic_bitset
 		 * @return result
 		 */
-		[[nodiscard]] constexpr bool is_intersects(const basic_dynamic_bitset& other) const
+		[[nodiscard]] GAL_DYNAMIC_BITSET_CONSTEXPR bool is_intersects(const basic_dynamic_bitset& other) const
 		noexcept(
 			noexcept(std::declval<container>()[0]))
 		{
 			const auto intersect_size = std::min(container_size(), other.container_size());
 
+			if (not details::is_constant_evaluated()) { return details::any<details::block_operation::bit_and>(container_.data(), other.container_.data(), intersect_size); }
+
 			for (size_type i = 0; i < intersect_size; ++i) { if (container_[i] bitand other.container_[i]) { return true; } }
 			return false;
 		}
@@ -1776,6 +2373,190 @@ namespace gal::toolbox::container
 		size_type total_{0};
 	};
 
+	template<bool Owning>
+	class dynamic_bitset_leaf
+	{
+	public:
+		using size_type = basic_dynamic_bitset::size_type;
+		using value_type = basic_dynamic_bitset::value_type;
+		using holder_type = std::conditional_t<Owning, basic_dynamic_bitset, const basic_dynamic_bitset*>;
+
+		constexpr explicit dynamic_bitset_leaf(const basic_dynamic_bitset& bitset) noexcept requires(not Owning)
+			: bitset_(std::addressof(bitset)) {}
+
+		constexpr explicit dynamic_bitset_leaf(basic_dynamic_bitset&& bitset) noexcept requires Owning
+			: bitset_(std::move(bitset)) {}
+
+		[[nodiscard]] constexpr size_type size() const noexcept { return get().size(); }
+
+		[[nodiscard]] constexpr value_type block(const size_type index) const noexcept { return get().container_[index]; }
+
+	private:
+		[[nodiscard]] constexpr const basic_dynamic_bitset& get() const noexcept
+		{
+			if constexpr (Owning) { return bitset_; }
+			else { return *bitset_; }
+		}
+
+		holder_type bitset_;
+	};
+
+	template<bool Owning>
+	constexpr bool is_dynamic_bitset_expression_v<dynamic_bitset_leaf<Owning>> = true;
+
+	/**
+	 * @brief lhs op rhs, evaluated block by block only when it is assigned to (or counted by count_of)
+	*/
+	template<details::block_operation Operation, typename Lhs, typename Rhs>
+	class dynamic_bitset_binary_expression
+	{
+	public:
+		using size_type = basic_dynamic_bitset::size_type;
+		using value_type = basic_dynamic_bitset::value_type;
+
+		GAL_ASSERT_CONSTEXPR dynamic_bitset_binary_expression(Lhs lhs, Rhs rhs) noexcept(std::is_nothrow_move_constructible_v<Lhs> and std::is_nothrow_move_constructible_v<Rhs>)
+			: lhs_(std::move(lhs)),
+			  rhs_(std::move(rhs)) { gal_assert(lhs_.size() == rhs_.size(), "the two operands are not the same size"); }
+
+		[[nodiscard]] constexpr size_type size() const noexcept { return lhs_.size(); }
+
+		[[nodiscard]] constexpr value_type block(const size_type index) const noexcept { return details::apply<Operation>(lhs_.block(index), rhs_.block(index)); }
+
+	private:
+		Lhs lhs_;
+		Rhs rhs_;
+	};
+
+	template<details::block_operation Operation, typename Lhs, typename Rhs>
+	constexpr bool is_dynamic_bitset_expression_v<dynamic_bitset_binary_expression<Operation, Lhs, Rhs>> = true;
+
+	/**
+	 * @brief ~expression, the unused bits of the last block are set, the consumer has to mask them
+	*/
+	template<typename Expression>
+	class dynamic_bitset_compl_expression
+	{
+	public:
+		using size_type = basic_dynamic_bitset::size_type;
+		using value_type = basic_dynamic_bitset::value_type;
+
+		constexpr explicit dynamic_bitset_compl_expression(Expression expression) noexcept(std::is_nothrow_move_constructible_v<Expression>)
+			: expression_(std::move(expression)) {}
+
+		[[nodiscard]] constexpr size_type size() const noexcept { return expression_.size(); }
+
+		[[nodiscard]] constexpr value_type block(const size_type index) const noexcept { return compl expression_.block(index); }
+
+	private:
+		Expression expression_;
+	};
+
+	template<typename Expression>
+	constexpr bool is_dynamic_bitset_expression_v<dynamic_bitset_compl_expression<Expression>> = true;
+
+	namespace dynamic_bitset_detail
+	{
+		/**
+		 * @brief an expression is stored by value, an lvalue bitset by pointer, an rvalue bitset is moved into the expression (so that it will not dangle)
+		*/
+		template<dynamic_bitset_operand Operand>
+		[[nodiscard]] constexpr auto make_node(Operand&& operand)
+		{
+			if constexpr (dynamic_bitset_expression<Operand>) { return std::remove_cvref_t<Operand>{std::forward<Operand>(operand)}; }
+			else if constexpr (std::is_lvalue_reference_v<Operand>) { return dynamic_bitset_leaf<false>{operand}; }
+			else { return dynamic_bitset_leaf<true>{std::move(operand)}; }
+		}
+
+		template<typename Operand>
+		using node_type = decltype(make_node(std::declval<Operand>()));
+
+		template<details::block_operation Operation, typename Lhs, typename Rhs>
+		[[nodiscard]] constexpr auto make_binary(Lhs&& lhs, Rhs&& rhs)
+		{
+			return dynamic_bitset_binary_expression<Operation, node_type<Lhs>, node_type<Rhs>>{
+					make_node(std::forward<Lhs>(lhs)),
+					make_node(std::forward<Rhs>(rhs))};
+		}
+	}// namespace dynamic_bitset_detail
+
+	/**
+	 * @brief lazy lhs & rhs, nothing is evaluated until it is assigned to a basic_dynamic_bitset (or counted by count_of)
+	 * @note the expression refers to the lvalue operands, do not let it outlive them
+	 */
+	template<dynamic_bitset_operand Lhs, dynamic_bitset_operand Rhs>
+	[[nodiscard]] constexpr auto operator bitand(Lhs&& lhs, Rhs&& rhs) { return dynamic_bitset_detail::make_binary<details::block_operation::bit_and>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)); }
+
+	/**
+	 * @brief lazy lhs | rhs
+	 */
+	template<dynamic_bitset_operand Lhs, dynamic_bitset_operand Rhs>
+	[[nodiscard]] constexpr auto operator bitor(Lhs&& lhs, Rhs&& rhs) { return dynamic_bitset_detail::make_binary<details::block_operation::bit_or>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)); }
+
+	/**
+	 * @brief lazy lhs ^ rhs
+	 */
+	template<dynamic_bitset_operand Lhs, dynamic_bitset_operand Rhs>
+	[[nodiscard]] constexpr auto operator xor(Lhs&& lhs, Rhs&& rhs) { return dynamic_bitset_detail::make_binary<details::block_operation::bit_xor>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)); }
+
+	/**
+	 * @brief lazy lhs - rhs (lhs & ~rhs)
+	 */
+	template<dynamic_bitset_operand Lhs, dynamic_bitset_operand Rhs>
+	[[nodiscard]] constexpr auto operator-(Lhs&& lhs, Rhs&& rhs) { return dynamic_bitset_detail::make_binary<details::block_operation::bit_and_not>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs)); }
+
+	/**
+	 * @brief lazy ~operand, assign it to a basic_dynamic_bitset to get a flipped copy
+	 */
+	template<dynamic_bitset_operand Operand>
+	[[nodiscard]] constexpr auto operator compl(Operand&& operand)
+	{
+		using node_type = dynamic_bitset_detail::node_type<Operand>;
+		return dynamic_bitset_compl_expression<node_type>{dynamic_bitset_detail::make_node(std::forward<Operand>(operand))};
+	}
+
+	/**
+	 * @brief count the set bits of a bitset or an expression, the expression is evaluated block by block and never allocates
+	 * @param operand bitset or expression
+	 * @return how many bits are set
+	 */
+	template<dynamic_bitset_operand Operand>
+	[[nodiscard]] constexpr basic_dynamic_bitset::size_type count_of(const Operand& operand)
+	{
+		using size_type = basic_dynamic_bitset::size_type;
+		using value_type = basic_dynamic_bitset::value_type;
+
+		if constexpr (not dynamic_bitset_expression<Operand>) { return operand.count(); }
+		else
+		{
+			const auto size = operand.size();
+			const auto blocks = basic_dynamic_bitset::bit_trait::block_index(size);
+			const auto extra_bits = basic_dynamic_bitset::bit_trait::bit_index(size);
+
+			size_type total = 0;
+			if (details::is_constant_evaluated())
+			{
+				for (size_type i = 0; i < blocks; ++i) { total += static_cast<size_type>(std::popcount(operand.block(i))); }
+			}
+			else
+			{
+				// evaluate a chunk on the stack, then count it with the vector kernels
+				constexpr size_type chunk_size = 256;
+				value_type chunk[chunk_size];
+				for (size_type begin = 0; begin < blocks; begin += chunk_size)
+				{
+					const auto end = std::min(blocks, begin + chunk_size);
+					for (size_type i = begin; i < end; ++i) { chunk[i - begin] = operand.block(i); }
+					total += details::popcount(chunk, end - begin);
+				}
+			}
+
+			// the unused bits of the last block may be set (by compl)
+			if (extra_bits not_eq 0) { total += static_cast<size_type>(std::popcount(operand.block(blocks) bitand ((value_type{1} << extra_bits) - 1))); }
+
+			return total;
+		}
+	}
+
 	template<typename Char, typename Trait>
 	std::basic_ostream<Char, Trait>& operator<<(
 			std::basic_ostream<Char, Trait>& os,
@@ -1848,7 +2629,7 @@ namespace gal::toolbox::container
 			os.width(0);
 		}
 
-		if (err not_eq std::ios_base::goodbit) { os.setstate(err); }
+		if (err not_eq std::ios_base::goodbit) { os.setstate(static_cast<std::ios_base::iostate>(err)); }
 		return os;
 	}
 
@@ -1896,7 +2677,7 @@ namespace gal::toolbox::container
 		}
 
 		if (bitset.empty()) { err or_eq std::ios_base::failbit; }
-		if (err not_eq std::ios_base::goodbit) { is.setstate(err); }
+		if (err not_eq std::ios_base::goodbit) { is.setstate(static_cast<std::ios_base::iostate>(err)); }
 		return is;
 	}
 }// namespace gal::toolbox::container
@@ -1905,4 +2686,3 @@ template<>
 struct std::iterator_traits<gal::toolbox::container::basic_dynamic_bitset::bit_iterator>
 		: gal::toolbox::container::basic_dynamic_bitset::bit_iterator { };
 
-#endif
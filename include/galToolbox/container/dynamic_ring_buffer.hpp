@@ -0,0 +1,403 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <galToolbox/utils/assert.hpp>
+
+#if defined(__linux__) and __has_include(<sys/mman.h>)
+	#include <sys/mman.h>
+	#include <unistd.h>
+	#define GAL_DYNAMIC_RING_BUFFER_MIRROR_SUPPORTED
+#endif
+
+namespace gal::toolbox::container
+{
+	/**
+	 * @brief a ring buffer whose capacity is decided at runtime (rounded up to 2^n),
+	 * elements are always stored sequentially (push at back and pop at front), see also sequential_ring_buffer
+	 * @tparam T value type
+	 * @tparam Alloc allocator type (only used by heap storage)
+	 * @note with mirrored storage the same physical memory is mapped twice back to back,
+	 * so the elements starting at any position are contiguous in the virtual address space even if they wrap around,
+	 * if the platform does not support it, the buffer silently falls back to heap storage (see `mirrored`)
+	*/
+	template<typename T, typename Alloc = std::allocator<T>>
+	class dynamic_ring_buffer
+	{
+	public:
+		using allocator_type = Alloc;
+		using allocator_trait_type = std::allocator_traits<allocator_type>;
+
+		using value_type = typename allocator_type::value_type;
+		using size_type = typename allocator_type::size_type;
+
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+		// a range of the buffer is at most split into two segments (the second one is empty if it does not wrap around)
+		using spans_type = std::array<std::span<value_type>, 2>;
+		using const_spans_type = std::array<std::span<const value_type>, 2>;
+
+		enum class storage_type
+		{
+			heap,
+			mirrored
+		};
+
+	private:
+		[[no_unique_address]] allocator_type allocator_;
+		pointer buffer_{nullptr};
+		size_type capacity_{0};
+		storage_type storage_{storage_type::heap};
+		// head_ and tail_ only increase, index_of maps them into buffer
+		size_type head_{0};
+		size_type tail_{0};
+
+		#ifdef GAL_DYNAMIC_RING_BUFFER_MIRROR_SUPPORTED
+		/**
+		 * @brief map the same memory twice back to back
+		 * @param bytes bytes of one mapping (must be a multiple of page size)
+		 * @return the first mapping, or nullptr if failed
+		*/
+		[[nodiscard]] static void* map_mirrored(const size_type bytes) noexcept
+		{
+			const auto fd = memfd_create("gal_dynamic_ring_buffer", MFD_CLOEXEC);
+			if (fd == -1) { return nullptr; }
+
+			void* result = nullptr;
+			if (ftruncate(fd, static_cast<off_t>(bytes)) == 0)
+			{
+				// reserve the address space first, then map the file over both halves
+				if (auto* base = static_cast<unsigned char*>(mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+					base != MAP_FAILED)
+				{
+					if (mmap(base, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED and
+					    mmap(base + bytes, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED) { result = base; }
+					else { munmap(base, 2 * bytes); }
+				}
+			}
+
+			close(fd);
+			return result;
+		}
+
+		static void unmap_mirrored(void* memory, const size_type bytes) noexcept { munmap(memory, 2 * bytes); }
+
+		[[nodiscard]] static size_type page_size() noexcept { return static_cast<size_type>(sysconf(_SC_PAGESIZE)); }
+		#endif
+
+		template<typename Value>
+		[[nodiscard]] std::array<std::span<Value>, 2> split(Value* buffer, const size_type begin, const size_type n) const noexcept
+		{
+			const auto index = index_of(begin);
+			// the mapping after the buffer is the buffer itself
+			const auto first = mirrored() ? n : std::min(n, capacity_ - index);
+			return {std::span<Value>{buffer + index, first}, std::span<Value>{buffer, n - first}};
+		}
+
+		void allocate(const size_type capacity, const storage_type storage)
+		{
+			capacity_ = std::bit_ceil(std::max(capacity, size_type{1}));
+			storage_ = storage_type::heap;
+
+			#ifdef GAL_DYNAMIC_RING_BUFFER_MIRROR_SUPPORTED
+			if (storage == storage_type::mirrored)
+			{
+				// the size of a mapping must be a multiple of page size, keep doubling the capacity until it is
+				const auto page = page_size();
+				while ((capacity_ * sizeof(value_type)) % page != 0) { capacity_ *= 2; }
+
+				if (auto* memory = map_mirrored(capacity_ * sizeof(value_type)); memory != nullptr)
+				{
+					buffer_ = static_cast<pointer>(memory);
+					storage_ = storage_type::mirrored;
+					return;
+				}
+			}
+			#else
+			(void)storage;
+			#endif
+
+			buffer_ = allocator_trait_type::allocate(allocator_, capacity_);
+		}
+
+		void deallocate() noexcept
+		{
+			if (buffer_ == nullptr) { return; }
+
+			clear();
+
+			#ifdef GAL_DYNAMIC_RING_BUFFER_MIRROR_SUPPORTED
+			if (storage_ == storage_type::mirrored) { unmap_mirrored(buffer_, capacity_ * sizeof(value_type)); }
+			else { allocator_trait_type::deallocate(allocator_, buffer_, capacity_); }
+			#else
+			allocator_trait_type::deallocate(allocator_, buffer_, capacity_);
+			#endif
+
+			buffer_ = nullptr;
+		}
+
+	public:
+		/**
+		 * @brief create a buffer which can hold at least capacity elements
+		 * @param capacity required capacity, rounded up to 2^n (mirrored storage may round up further to fit page size)
+		 * @param storage heap or mirrored
+		*/
+		explicit dynamic_ring_buffer(const size_type capacity, const storage_type storage = storage_type::heap) { allocate(capacity, storage); }
+
+		~dynamic_ring_buffer() noexcept { deallocate(); }
+
+		dynamic_ring_buffer(const dynamic_ring_buffer& other)
+			: dynamic_ring_buffer(other.capacity_, other.storage_) { paste(other); }
+
+		dynamic_ring_buffer& operator=(const dynamic_ring_buffer& other)
+		{
+			if (std::addressof(other) == this) { return *this; }
+
+			// other may be larger (or use another storage) than us, take its capacity as well
+			*this = dynamic_ring_buffer{other};
+
+			return *this;
+		}
+
+		dynamic_ring_buffer(dynamic_ring_buffer&& other) noexcept
+			: buffer_(std::exchange(other.buffer_, nullptr)),
+			  capacity_(std::exchange(other.capacity_, 0)),
+			  storage_(other.storage_),
+			  head_(std::exchange(other.head_, 0)),
+			  tail_(std::exchange(other.tail_, 0)) {}
+
+		dynamic_ring_buffer& operator=(dynamic_ring_buffer&& other) noexcept
+		{
+			if (std::addressof(other) == this) { return *this; }
+
+			deallocate();
+			buffer_ = std::exchange(other.buffer_, nullptr);
+			capacity_ = std::exchange(other.capacity_, 0);
+			storage_ = other.storage_;
+			head_ = std::exchange(other.head_, 0);
+			tail_ = std::exchange(other.tail_, 0);
+			return *this;
+		}
+
+		[[nodiscard]] size_type capacity() const noexcept { return capacity_; }
+
+		[[nodiscard]] size_type size() const noexcept { return tail_ - head_; }
+
+		[[nodiscard]] bool empty() const noexcept { return head_ == tail_; }
+
+		[[nodiscard]] bool full() const noexcept { return size() == capacity_; }
+
+		/**
+		 * @brief is the memory mapped twice back to back?
+		 * @return mirrored or not
+		*/
+		[[nodiscard]] bool mirrored() const noexcept { return storage_ == storage_type::mirrored; }
+
+		/**
+		 * @brief get where the pos actually in
+		 * @param pos given pos
+		 * @return actually index
+		*/
+		[[nodiscard]] size_type index_of(const size_type pos) const noexcept { return pos bitand (capacity_ - 1); }
+
+		/**
+		 * @brief get the i-th element's reference (counting from the front)
+		 * @param index element's index
+		 * @return reference
+		*/
+		GAL_ASSERT_CONSTEXPR reference operator[](const size_type index) noexcept
+		{
+			gal_assert(index < size(), "index out of range");
+			return buffer_[index_of(head_ + index)];
+		}
+
+		/**
+		 * @brief get the i-th element's reference (counting from the front)
+		 * @param index element's index
+		 * @return const_reference
+		*/
+		GAL_ASSERT_CONSTEXPR const_reference operator[](const size_type index) const noexcept
+		{
+			gal_assert(index < size(), "index out of range");
+			return buffer_[index_of(head_ + index)];
+		}
+
+		GAL_ASSERT_CONSTEXPR reference front() noexcept { return this->operator[](0); }
+
+		GAL_ASSERT_CONSTEXPR const_reference front() const noexcept { return this->operator[](0); }
+
+		GAL_ASSERT_CONSTEXPR reference back() noexcept { return this->operator[](size() - 1); }
+
+		GAL_ASSERT_CONSTEXPR const_reference back() const noexcept { return this->operator[](size() - 1); }
+
+		/**
+		 * @brief construct a new element at the back
+		 * @param args args
+		 * @return push result (false if the buffer is full)
+		*/
+		template<typename... Args>
+		bool push(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args...>)
+		{
+			if (full()) { return false; }
+
+			allocator_trait_type::construct(allocator_, buffer_ + index_of(tail_), value_type{std::forward<Args>(args)...});
+			++tail_;
+			return true;
+		}
+
+		/**
+		 * @brief move the front element out and destroy it
+		 * @param data a reference to receive data
+		 * @return pop result (false if the buffer is empty)
+		*/
+		bool pop(reference data) noexcept(std::is_nothrow_move_assignable_v<value_type>)
+		{
+			if (empty()) { return false; }
+
+			data = std::move(front());
+			return pop();
+		}
+
+		/**
+		 * @brief destroy the front element
+		 * @return pop result (false if the buffer is empty)
+		*/
+		bool pop() noexcept
+		{
+			if (empty()) { return false; }
+
+			allocator_trait_type::destroy(allocator_, buffer_ + index_of(head_));
+			++head_;
+			return true;
+		}
+
+		/**
+		 * @brief copy as many elements as possible to the back
+		 * @param data source
+		 * @param count how many elements in source
+		 * @return how many elements were copied
+		 * @note one memcpy with mirrored storage, at most two with heap storage
+		*/
+		size_type push_bulk(const_pointer data, const size_type count) noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			const auto n = std::min(count, capacity_ - size());
+			if (n == 0) { return 0; }
+
+			const auto index = index_of(tail_);
+			if (const auto first = mirrored() ? n : std::min(n, capacity_ - index); first == n) { std::memcpy(buffer_ + index, data, n * sizeof(value_type)); }
+			else
+			{
+				std::memcpy(buffer_ + index, data, first * sizeof(value_type));
+				std::memcpy(buffer_, data + first, (n - first) * sizeof(value_type));
+			}
+
+			tail_ += n;
+			return n;
+		}
+
+		/**
+		 * @brief copy as many elements as possible from the front, and remove them
+		 * @param data dest
+		 * @param count how many elements the dest can hold
+		 * @return how many elements were copied
+		 * @note one memcpy with mirrored storage, at most two with heap storage
+		*/
+		size_type pop_bulk(pointer data, const size_type count) noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			const auto n = std::min(count, size());
+			if (n == 0) { return 0; }
+
+			const auto index = index_of(head_);
+			if (const auto first = mirrored() ? n : std::min(n, capacity_ - index); first == n) { std::memcpy(data, buffer_ + index, n * sizeof(value_type)); }
+			else
+			{
+				std::memcpy(data, buffer_ + index, first * sizeof(value_type));
+				std::memcpy(data + first, buffer_, (n - first) * sizeof(value_type));
+			}
+
+			head_ += n;
+			return n;
+		}
+
+		/**
+		 * @brief get the memory of all elements (from front to back)
+		 * @return up to two segments
+		 * @note with mirrored storage the second segment is always empty
+		*/
+		[[nodiscard]] spans_type readable_spans() noexcept { return split(buffer_, head_, size()); }
+
+		/**
+		 * @brief get the memory of all elements (from front to back)
+		 * @return up to two segments
+		 * @note with mirrored storage the second segment is always empty
+		*/
+		[[nodiscard]] const_spans_type readable_spans() const noexcept { return split(static_cast<const_pointer>(buffer_), head_, size()); }
+
+		/**
+		 * @brief get the raw memory after the back element, write into it and then `commit` it
+		 * @return up to two segments
+		 * @note with mirrored storage the second segment is always empty
+		*/
+		[[nodiscard]] spans_type writable_spans() noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			return split(buffer_, tail_, capacity_ - size());
+		}
+
+		/**
+		 * @brief append n elements to the back (after writing into the memory returned by `writable_spans`)
+		 * @param n how many elements
+		*/
+		GAL_ASSERT_CONSTEXPR void commit(const size_type n) noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			gal_assert(n <= capacity_ - size(), "commit more elements than the available space");
+			tail_ += n;
+		}
+
+		/**
+		 * @brief remove n elements from the front (after reading from the memory returned by `readable_spans`)
+		 * @param n how many elements
+		*/
+		GAL_ASSERT_CONSTEXPR void consume(const size_type n) noexcept
+		{
+			gal_assert(n <= size(), "consume more elements than exist");
+			if constexpr (std::is_trivially_destructible_v<value_type>) { head_ += n; }
+			else { for (size_type i = 0; i < n; ++i) { pop(); } }
+		}
+
+		/**
+		 * @brief destroy all elements
+		*/
+		void clear() noexcept
+		{
+			if constexpr (not std::is_trivially_destructible_v<value_type>)
+			{
+				for (; head_ != tail_; ++head_) { allocator_trait_type::destroy(allocator_, buffer_ + index_of(head_)); }
+			}
+			head_ = tail_ = 0;
+		}
+
+		/**
+		 * @brief paste another dynamic_ring_buffer's elements to the back of this dynamic_ring_buffer
+		 * @note stop when this buffer is full
+		*/
+		template<std::convertible_to<value_type> U, typename Allocator>
+		void paste(const dynamic_ring_buffer<U, Allocator>& other)
+		{
+			for (size_type i = 0; i < other.size() and not full(); ++i) { this->push(static_cast<value_type>(other[i])); }
+		}
+	};
+}// namespace gal::toolbox::container
@@ -1,31 +1,86 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <iterator>
 #include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
 
 #include <galToolbox/container/ring_buffer.hpp>
+#include <galToolbox/utils/cache_line.hpp>
+#include <galToolbox/utils/cpu_relax.hpp>
 
 namespace gal::toolbox::container
 {
-	template<typename T, std::size_t N, typename Alloc = std::allocator<T>>
+	/**
+	 * @brief how a waiting consumer of fifo goes to sleep
+	*/
+	enum class fifo_park_type
+	{
+		// block on a condition_variable (under the consumer's mutex)
+		condition_variable,
+		// block on std::atomic::wait of the element count (a futex on linux, WaitOnAddress on windows)
+		atomic_wait
+	};
+
+	/**
+	 * @brief how a consumer of fifo waits for data
+	 * @tparam SpinCount how many times to re-check the fifo before parking
+	 * @tparam Park how to park after spinning
+	 * @note producers only notify when there is a parked consumer, spinning consumers are never notified
+	*/
+	template<std::size_t SpinCount, fifo_park_type Park>
+	struct fifo_wait_policy
+	{
+		constexpr static std::size_t spin_count = SpinCount;
+		constexpr static fifo_park_type park = Park;
+	};
+
+	using fifo_default_wait_policy = fifo_wait_policy<0, fifo_park_type::condition_variable>;
+	// spin a while for low wake-up latency, then park on the futex so that an idle consumer does not burn a core
+	using fifo_spin_then_park_policy = fifo_wait_policy<4096, fifo_park_type::atomic_wait>;
+
+	/**
+	 * @brief a multi-producer/multi-consumer fifo with a fixed capacity
+	 * @tparam T value type
+	 * @tparam N capacity (must be 2^n)
+	 * @tparam Alloc allocator type
+	 * @tparam IsSlotPadded whether every element occupies its own cache line(s),
+	 * this avoids a producer and a consumer working on adjacent elements from sharing a cache line (only worth it for large elements)
+	 * @tparam WaitPolicy how a consumer waits for data, see fifo_wait_policy
+	 * @note the producer side state, the consumer side state and the shared counter live on separate cache lines
+	*/
+	template<typename T, std::size_t N, typename Alloc = std::allocator<T>, bool IsSlotPadded = false, typename WaitPolicy = fifo_default_wait_policy>
 	class fifo
 	{
+		struct alignas(utils::cache_line_size) padded_slot
+		{
+			T value;
+		};
+
+		using slot_type = std::conditional_t<IsSlotPadded, padded_slot, T>;
+
 	public:
-		using internal_type = ring_buffer<T, N, Alloc>;
+		using internal_type = ring_buffer<slot_type, N, typename std::allocator_traits<Alloc>::template rebind_alloc<slot_type>>;
 
-		using value_tye = typename internal_type::value_type;
+		using value_tye = T;
 		using size_type = typename internal_type::size_type;
 
 		constexpr static size_type max_size = internal_type::max_size;
+		constexpr static bool is_slot_padded = IsSlotPadded;
+
+		using wait_policy = WaitPolicy;
 
 		using time_type = size_type;
 
-		using reference = typename internal_type::reference;
-		using const_reference = typename internal_type::const_reference;
-		using pointer = typename internal_type::pointer;
-		using const_pointer = typename internal_type::const_pointer;
+		using reference = value_tye&;
+		using const_reference = const value_tye&;
+		using pointer = value_tye*;
+		using const_pointer = const value_tye*;
 
 		constexpr explicit fifo() noexcept = default;
 
@@ -33,12 +88,18 @@ namespace gal::toolbox::container
 		 * @brief get the size of the currently existing data
 		 * @return size
 		*/
-		constexpr size_type size() const noexcept { return buffer_.distance(consumer_, producer_); }
+		constexpr size_type size() const noexcept { return count_.load(); }
 
 		[[nodiscard]] constexpr bool full() const noexcept { return count_.load() == max_size; }
 
 		[[nodiscard]] constexpr bool empty() const noexcept { return count_.load() == 0; }
 
+		/**
+		 * @brief get how many data have been dropped by `push_force`
+		 * @return dropped count
+		*/
+		[[nodiscard]] size_type dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
 		/**
 		 * @brief push a new data into ring buffer
 		 * @tparam Args args' type
@@ -46,8 +107,7 @@ namespace gal::toolbox::container
 		 * @return push result
 		*/
 		template<typename... Args>
-		bool push(Args&&... args) noexcept(
-			noexcept(std::declval<internal_type>().template set_or_overwrite(std::declval<size_type>(), std::declval<decltype(std::forward<Args>(args))>()...)))
+		bool push(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_tye, Args...>)
 		{
 			if (full()) { return false; }
 
@@ -55,31 +115,76 @@ namespace gal::toolbox::container
 				std::scoped_lock lock(write_mutex_);
 				if (full()) { return false; }
 
-				buffer_.set_or_overwrite(producer_, std::forward<Args>(args)...);
+				store(producer_, std::forward<Args>(args)...);
 				++producer_;
 				++count_;
 			}
-			read_cond_.notify_one();
+			notify_consumers(1);
 			return true;
 		}
 
 		/**
-		 * @brief push a new data into ring buffer, it will overwrite exist data
+		 * @brief push a new data into ring buffer, if it is full, the oldest data will be dropped (and counted in `dropped`)
 		 * @tparam Args args' type
 		 * @param args the parameters must be constructable into the value_type
+		 * @note see mpmc_fifo with overflow_policy::overwrite_oldest for a lock-free "keep latest N" fifo
 		*/
 		template<typename... Args>
-		void push_force(Args&&... args) noexcept(
-			noexcept(std::declval<internal_type>().template set_or_overwrite(std::declval<size_type>(), std::declval<decltype(std::forward<Args>(args))>()...)))
+		void push_force(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_tye, Args...>)
 		{
 			{
 				std::scoped_lock lock(write_mutex_);
 
-				buffer_.set_or_overwrite(producer_, std::forward<Args>(args)...);
+				if (full())
+				{
+					// the consumers may be reading the oldest data right now
+					std::scoped_lock read_lock(read_mutex_);
+					if (full())
+					{
+						// the oldest data lives where the new data goes, hand it over to the producer
+						++consumer_;
+						--count_;
+						dropped_.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+
+				store(producer_, std::forward<Args>(args)...);
 				++producer_;
 				++count_;
 			}
-			read_cond_.notify_one();
+			notify_consumers(1);
+		}
+
+		/**
+		 * @brief push as many data of the range as possible into ring buffer,
+		 * the free slots are reserved under one lock and consumers are woken up once for the whole batch
+		 * @tparam Range range type
+		 * @param range the elements of range must be constructable into the value_type
+		 * @return how many data were pushed (stop at the first element that does not fit)
+		*/
+		template<std::ranges::input_range Range>
+			requires std::constructible_from<value_tye, std::ranges::range_reference_t<Range>>
+		size_type push_bulk(Range&& range)
+		{
+			if (full()) { return 0; }
+
+			size_type pushed = 0;
+			{
+				std::scoped_lock lock(write_mutex_);
+
+				// consumers can only make more space while we are holding the write lock
+				const auto space = max_size - count_.load();
+
+				auto begin = std::ranges::begin(range);
+				const auto end = std::ranges::end(range);
+				for (; pushed < space and begin != end; ++pushed, ++begin) { store(producer_ + pushed, *begin); }
+
+				producer_ += pushed;
+				count_ += pushed;
+			}
+
+			notify_consumers(pushed);
+			return pushed;
 		}
 
 		/**
@@ -94,16 +199,9 @@ namespace gal::toolbox::container
 		bool pop(reference data, time_type wait_milliseconds_time = 0)
 		{
 			std::unique_lock lock(read_mutex_);
-			if (empty())
-			{
-				if (wait_milliseconds_time == static_cast<time_type>(-1)) { return false; }
-				if (wait_milliseconds_time == 0) { read_cond_.wait(lock); }
-				else { read_cond_.wait_for(lock, std::chrono::milliseconds(wait_milliseconds_time)); }
+			if (not wait_for_data(lock, wait_milliseconds_time)) { return false; }
 
-				if (empty()) { return false; }
-			}
-
-			data = buffer_[consumer_];
+			data = load(consumer_);
 			// the following line is just to prevent the IDE from warning us "Never used value"
 			(void)data;
 			++consumer_;
@@ -111,6 +209,33 @@ namespace gal::toolbox::container
 			return true;
 		}
 
+		/**
+		 * @brief pop up to max_count data from ring buffer,
+		 * the existing data are reserved under one lock and moved out in a tight loop
+		 * @tparam OutputIterator output iterator type
+		 * @param out where to write the popped data
+		 * @param max_count the maximum number of data to pop
+		 * @param wait_milliseconds_time maximum time willing to wait (milliseconds) if there is nothing to pop,
+		 * for more detail, see `pop` with two arguments
+		 * @return how many data were popped
+		*/
+		template<std::output_iterator<value_tye> OutputIterator>
+		size_type pop_bulk(OutputIterator out, const size_type max_count, time_type wait_milliseconds_time = 0)
+		{
+			if (max_count == 0) { return 0; }
+
+			std::unique_lock lock(read_mutex_);
+			if (not wait_for_data(lock, wait_milliseconds_time)) { return 0; }
+
+			// producers can only add more data while we are holding the read lock
+			const auto popped = std::min(max_count, count_.load());
+			for (size_type i = 0; i < popped; ++i, ++out) { *out = std::move(load(consumer_ + i)); }
+
+			consumer_ += popped;
+			count_ -= popped;
+			return popped;
+		}
+
 		/**
 		 * @brief pop a data from ring buffer but ignore what is popped
 		 * @param wait_milliseconds_time maximum time willing to wait (milliseconds)
@@ -124,16 +249,112 @@ namespace gal::toolbox::container
 			return pop(dummy, wait_milliseconds_time);
 		}
 
-	private :
-		internal_type buffer_;
-		size_type producer_;
-		size_type consumer_;
+	private:
+		template<typename... Args>
+		void store(const size_type index, Args&&... args) noexcept(std::is_nothrow_constructible_v<value_tye, Args...>)
+		{
+			if constexpr (is_slot_padded) { buffer_.set_or_overwrite(index, value_tye{std::forward<Args>(args)...}); }
+			else { buffer_.set_or_overwrite(index, std::forward<Args>(args)...); }
+		}
 
-		std::atomic<size_type> count_;
+		[[nodiscard]] reference load(const size_type index) noexcept
+		{
+			if constexpr (is_slot_padded) { return buffer_[index].value; }
+			else { return buffer_[index]; }
+		}
 
-		std::mutex read_mutex_;
+		/**
+		 * @brief wait until there is something to pop (holding the read lock)
+		 * @param lock the read lock
+		 * @param wait_milliseconds_time see `pop`
+		 * @return whether there is something to pop
+		*/
+		bool wait_for_data(std::unique_lock<std::mutex>& lock, const time_type wait_milliseconds_time)
+		{
+			if (not empty()) { return true; }
+			if (wait_milliseconds_time == static_cast<time_type>(-1)) { return false; }
+
+			for (std::size_t i = 0; i < wait_policy::spin_count; ++i)
+			{
+				if (not empty()) { return true; }
+				utils::cpu_relax();
+			}
+
+			if constexpr (wait_policy::park == fifo_park_type::condition_variable)
+			{
+				// pair with notify_consumers, either we see the new count or the producer sees us sleeping
+				sleepers_.fetch_add(1);
+				const auto ready = [this] { return not empty(); };
+				if (wait_milliseconds_time == 0) { read_cond_.wait(lock, ready); }
+				else { read_cond_.wait_for(lock, std::chrono::milliseconds(wait_milliseconds_time), ready); }
+				sleepers_.fetch_sub(1);
+			}
+			else
+			{
+				if (wait_milliseconds_time == 0)
+				{
+					// pair with notify_consumers, either we see the new count or the producer sees us sleeping
+					sleepers_.fetch_add(1);
+					// atomic::wait only blocks while the count is still 0, a notification can not be lost
+					while (empty()) { count_.wait(0); }
+					sleepers_.fetch_sub(1);
+				}
+				else
+				{
+					// atomic::wait has no timeout, poll with an exponential back-off until the deadline instead
+					const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(wait_milliseconds_time);
+					std::chrono::microseconds backoff{1};
+					for (auto now = std::chrono::steady_clock::now(); empty() and now < deadline; now = std::chrono::steady_clock::now())
+					{
+						std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(backoff, deadline - now));
+						backoff = std::min(backoff * 2, std::chrono::microseconds{1000});
+					}
+				}
+			}
+
+			return not empty();
+		}
+
+		/**
+		 * @brief wake up the parked consumers after n data were pushed (count_ must have been updated)
+		 * @param n how many data were pushed
+		*/
+		void notify_consumers(const size_type n)
+		{
+			// nobody is parked, skip the syscall
+			if (n == 0 or sleepers_.load() == 0) { return; }
+
+			if constexpr (wait_policy::park == fifo_park_type::condition_variable)
+			{
+				// the consumer checks the count under the read lock, so it is either not waiting yet or will receive this notification
+				{ std::scoped_lock lock(read_mutex_); }
+				if (n == 1) { read_cond_.notify_one(); }
+				else { read_cond_.notify_all(); }
+			}
+			else
+			{
+				// only the consumer holding the read lock can be parked on the count
+				count_.notify_one();
+			}
+		}
+
+		// shared, the slots themselves are only touched by the side owning the index
+		internal_type buffer_;
+
+		// producer side
+		alignas(utils::cache_line_size) size_type producer_{0};
 		std::mutex write_mutex_;
+		std::atomic<size_type> dropped_{0};
 
+		// consumer side
+		alignas(utils::cache_line_size) size_type consumer_{0};
+		std::mutex read_mutex_;
 		std::condition_variable read_cond_;
+
+		// the only state written by both sides
+		alignas(utils::cache_line_size) std::atomic<size_type> count_{0};
+
+		// read by every producer but only written when a consumer parks
+		alignas(utils::cache_line_size) std::atomic<size_type> sleepers_{0};
 	};
 }// namespace gal::toolbox::container
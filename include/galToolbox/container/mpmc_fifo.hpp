@@ -0,0 +1,224 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <galToolbox/utils/cache_line.hpp>
+
+namespace gal::toolbox::container
+{
+	/**
+	 * @brief what a producer does when the fifo is full
+	*/
+	enum class fifo_overflow_policy
+	{
+		// the push fails
+		reject,
+		// the oldest data is dropped to make room ("keep latest N"), the push never fails
+		overwrite_oldest
+	};
+
+	/**
+	 * @brief a bounded multi-producer/multi-consumer fifo with a fixed capacity
+	 * @tparam T value type
+	 * @tparam N capacity (must be 2^n)
+	 * @tparam Alloc allocator type
+	 * @tparam Overflow what a producer does when the fifo is full
+	 * @note every slot carries its own sequence counter (instead of a shared occupancy bitset),
+	 * a producer/consumer claims a position with a single CAS on the enqueue/dequeue index and then only touches its own slot,
+	 * so any number of threads can push/pop without a mutex
+	*/
+	template<typename T, std::size_t N, typename Alloc = std::allocator<T>, fifo_overflow_policy Overflow = fifo_overflow_policy::reject>
+	class mpmc_fifo
+	{
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		using difference_type = std::make_signed_t<size_type>;
+
+		constexpr static size_type max_size = N;
+		constexpr static size_type mask = max_size - 1;
+		static_assert((max_size & mask) == 0, "capacity must be 2^n");
+
+		constexpr static fifo_overflow_policy overflow = Overflow;
+
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+	private:
+		struct slot
+		{
+			// sequence == position       --> free, waiting for the producer of `position`
+			// sequence == position + 1   --> constructed, waiting for the consumer of `position`
+			std::atomic<size_type> sequence;
+			alignas(value_type) std::byte storage[sizeof(value_type)];
+
+			[[nodiscard]] pointer data() noexcept { return std::launder(reinterpret_cast<pointer>(storage)); }
+		};
+
+	public:
+		using allocator_type = typename std::allocator_traits<Alloc>::template rebind_alloc<slot>;
+		using allocator_trait_type = std::allocator_traits<allocator_type>;
+
+		mpmc_fifo()
+			: slots_(allocator_trait_type::allocate(allocator_, max_size))
+		{
+			for (size_type i = 0; i < max_size; ++i)
+			{
+				allocator_trait_type::construct(allocator_, slots_ + i);
+				slots_[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		mpmc_fifo(const mpmc_fifo&) = delete;
+		mpmc_fifo& operator=(const mpmc_fifo&) = delete;
+		mpmc_fifo(mpmc_fifo&&) = delete;
+		mpmc_fifo& operator=(mpmc_fifo&&) = delete;
+
+		~mpmc_fifo() noexcept(std::is_nothrow_destructible_v<value_type>)
+		{
+			if constexpr (not std::is_trivially_destructible_v<value_type>)
+			{
+				// the elements between dequeue and enqueue have been constructed but not consumed
+				for (auto i = dequeue_.load(std::memory_order_relaxed), end = enqueue_.load(std::memory_order_relaxed); i != end; ++i)
+				{
+					std::destroy_at(slots_[i bitand mask].data());
+				}
+			}
+
+			for (size_type i = 0; i < max_size; ++i) { allocator_trait_type::destroy(allocator_, slots_ + i); }
+
+			allocator_trait_type::deallocate(allocator_, slots_, max_size);
+			slots_ = nullptr;
+		}
+
+		/**
+		 * @brief get the size of the currently existing data
+		 * @return size
+		 * @note only a snapshot if other threads are working at the same time
+		*/
+		[[nodiscard]] size_type size() const noexcept
+		{
+			const auto dequeue = dequeue_.load(std::memory_order_acquire);
+			const auto enqueue = enqueue_.load(std::memory_order_acquire);
+			// the two loads are not atomic as a whole, a consumer may overtake our snapshot of enqueue
+			return enqueue > dequeue ? enqueue - dequeue : 0;
+		}
+
+		[[nodiscard]] bool full() const noexcept { return size() >= max_size; }
+
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+		/**
+		 * @brief get how many data have been dropped to make room for new data (only for overwrite_oldest)
+		 * @return dropped count
+		*/
+		[[nodiscard]] size_type dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief push a new data into fifo
+		 * @tparam Args args' type
+		 * @param args the parameters must be constructable into the value_type
+		 * @return push result (false if the fifo is full, always true for overwrite_oldest)
+		*/
+		template<typename... Args>
+		bool push(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args...>)
+		{
+			auto position = enqueue_.load(std::memory_order_relaxed);
+			slot* s;
+			for (;;)
+			{
+				s = slots_ + (position bitand mask);
+				const auto sequence = s->sequence.load(std::memory_order_acquire);
+
+				if (const auto diff = static_cast<difference_type>(sequence) - static_cast<difference_type>(position);
+					diff == 0)
+				{
+					// the slot is free, try to claim it
+					if (enqueue_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+				}
+				else if (diff < 0)
+				{
+					// the slot still holds the element of the last round
+					if constexpr (overflow == fifo_overflow_policy::reject) { return false; }
+					else
+					{
+						// act as the consumer of the element in our slot and drop it,
+						// if a consumer (or another producer) claimed it first, it will free the slot soon
+						if (auto oldest = position - max_size;
+							sequence == oldest + 1 and dequeue_.compare_exchange_strong(oldest, oldest + 1, std::memory_order_relaxed))
+						{
+							std::destroy_at(s->data());
+							s->sequence.store(position, std::memory_order_release);
+							dropped_.fetch_add(1, std::memory_order_relaxed);
+						}
+						else { position = enqueue_.load(std::memory_order_relaxed); }
+					}
+				}
+				else
+				{
+					// another producer claimed this position
+					position = enqueue_.load(std::memory_order_relaxed);
+				}
+			}
+
+			std::construct_at(reinterpret_cast<pointer>(s->storage), value_type{std::forward<Args>(args)...});
+			s->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief pop a data from fifo without waiting
+		 * @param data a reference to receive data
+		 * @return pop success or not (false if the fifo is empty)
+		*/
+		bool try_pop(reference data) noexcept(std::is_nothrow_move_assignable_v<value_type>)
+		{
+			auto position = dequeue_.load(std::memory_order_relaxed);
+			slot* s;
+			for (;;)
+			{
+				s = slots_ + (position bitand mask);
+				const auto sequence = s->sequence.load(std::memory_order_acquire);
+
+				if (const auto diff = static_cast<difference_type>(sequence) - static_cast<difference_type>(position + 1);
+					diff == 0)
+				{
+					// the slot is constructed, try to claim it
+					if (dequeue_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+				}
+				else if (diff < 0)
+				{
+					// the producer of this position has not finished yet
+					return false;
+				}
+				else
+				{
+					// another consumer claimed this position
+					position = dequeue_.load(std::memory_order_relaxed);
+				}
+			}
+
+			const auto p = s->data();
+			data = std::move(*p);
+			std::destroy_at(p);
+			// free for the producer of the next round
+			s->sequence.store(position + max_size, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		// shared, read only
+		[[no_unique_address]] allocator_type allocator_;
+		slot* slots_;
+
+		alignas(utils::cache_line_size) std::atomic<size_type> enqueue_{0};
+		std::atomic<size_type> dropped_{0};
+		alignas(utils::cache_line_size) std::atomic<size_type> dequeue_{0};
+	};
+}// namespace gal::toolbox::container
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <array>
 #include <bitset>
 #include <iterator>
 #include <memory>
 #include <ranges>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 #include <galToolbox/utils/assert.hpp>
 
@@ -36,6 +39,10 @@ namespace gal::toolbox::container
 		using pointer = value_type*;
 		using const_pointer = const value_type*;
 
+		// a range of the buffer is at most split into two segments (the second one is empty if it does not wrap around)
+		using spans_type = std::array<std::span<value_type>, 2>;
+		using const_spans_type = std::array<std::span<const value_type>, 2>;
+
 		constexpr ring_buffer() noexcept
 			: buffer_(allocator_trait_type::allocate(allocator_, max_size)) {}
 
@@ -240,6 +247,70 @@ namespace gal::toolbox::container
 			return this->operator[](index);
 		}
 
+		/**
+		 * @brief get the memory of the elements between begin and end
+		 * @param begin given begin
+		 * @param end given end (end - begin must not greater than max_size)
+		 * @return up to two segments
+		 * @note if the elements between begin and end have not been constructed, the behavior is undefined
+		*/
+		[[nodiscard]] GAL_ASSERT_CONSTEXPR spans_type readable_spans(size_type begin, size_type end) noexcept
+		{
+			gal_assert(end - begin <= max_size, "range greater than the capacity");
+			return split(buffer_, begin, end - begin);
+		}
+
+		/**
+		 * @brief get the memory of the elements between begin and end
+		 * @param begin given begin
+		 * @param end given end (end - begin must not greater than max_size)
+		 * @return up to two segments
+		 * @note if the elements between begin and end have not been constructed, the behavior is undefined
+		*/
+		[[nodiscard]] GAL_ASSERT_CONSTEXPR const_spans_type readable_spans(size_type begin, size_type end) const noexcept
+		{
+			gal_assert(end - begin <= max_size, "range greater than the capacity");
+			return split(static_cast<const_pointer>(buffer_), begin, end - begin);
+		}
+
+		/**
+		 * @brief get the raw memory between begin and end, write into it and then `commit` it
+		 * @param begin given begin
+		 * @param end given end (end - begin must not greater than max_size)
+		 * @return up to two segments
+		 * @note if the elements between begin and end have been constructed, they will be overwritten without destructing
+		*/
+		[[nodiscard]] GAL_ASSERT_CONSTEXPR spans_type writable_spans(size_type begin, size_type end) noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			gal_assert(end - begin <= max_size, "range greater than the capacity");
+			return split(buffer_, begin, end - begin);
+		}
+
+		/**
+		 * @brief mark n elements from begin as constructed (after writing into the memory returned by `writable_spans`)
+		 * @param begin given begin
+		 * @param n how many elements
+		*/
+		GAL_ASSERT_CONSTEXPR void commit(size_type begin, size_type n) noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			gal_assert(n <= max_size, "range greater than the capacity");
+			for (size_type i = 0; i < n; ++i) { bit_checker_.set(index_of(begin + i)); }
+		}
+
+		/**
+		 * @brief erase n elements from begin (after reading from the memory returned by `readable_spans`)
+		 * @param begin given begin
+		 * @param n how many elements
+		 * @note if the elements have not been constructed, the behavior is undefined
+		*/
+		GAL_ASSERT_CONSTEXPR void consume(size_type begin, size_type n) noexcept
+		{
+			gal_assert(n <= max_size, "range greater than the capacity");
+			for (size_type i = 0; i < n; ++i) { erase(begin + i); }
+		}
+
 		/**
 		 * @brief paste another ring_buffer's elements into this ring_buffer
 		*/
@@ -259,6 +330,14 @@ namespace gal::toolbox::container
 
 
 	private:
+		template<typename Value>
+		[[nodiscard]] constexpr static std::array<std::span<Value>, 2> split(Value* buffer, size_type begin, size_type n) noexcept
+		{
+			const auto index = begin bitand mask;
+			const auto first = std::min(n, max_size - index);
+			return {std::span<Value>{buffer + index, first}, std::span<Value>{buffer, n - first}};
+		}
+
 		pointer buffer_;
 		bit_checker_type bit_checker_;
 
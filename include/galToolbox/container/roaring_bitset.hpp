@@ -0,0 +1,805 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <galToolbox/container/details/dynamic_bitset_kernel.hpp>
+#include <galToolbox/container/dynamic_bitset.hpp>
+#include <galToolbox/utils/assert.hpp>
+
+namespace gal::toolbox::container
+{
+	/**
+	 * @brief a compressed bitset of 32-bit values (a roaring bitmap)
+	 * @note the universe is split into 2^16 buckets by the high 16 bits of the value, only the non-empty buckets are stored,
+	 * each bucket stores the low 16 bits in the smallest of three containers:
+	 * a sorted array (up to 4096 values), a bitmap (65536 bits, 8KB) or a list of runs (after run_optimize()).
+	 * a sparse set of a few thousand values out of 2^32 costs a few KB instead of the 512MB of a basic_dynamic_bitset
+	*/
+	class roaring_bitset
+	{
+	public:
+		using value_type = std::uint32_t;
+		using size_type = std::size_t;
+
+		// the high 16 bits of the value
+		using key_type = std::uint16_t;
+		// the low 16 bits of the value
+		using low_type = std::uint16_t;
+
+		constexpr static size_type bits_of_bucket = size_type{1} << 16;
+		// an array container up to this cardinality is not bigger than a bitmap container
+		constexpr static size_type array_max_cardinality = 4096;
+
+	private:
+		using block_type = details::block_type;
+
+		constexpr static size_type bits_of_block = 64;
+		constexpr static size_type blocks_of_bitmap = bits_of_bucket / bits_of_block;
+
+		struct array_container
+		{
+			// sorted
+			std::vector<low_type> values;
+		};
+
+		struct bitmap_container
+		{
+			std::vector<block_type> blocks = std::vector<block_type>(blocks_of_bitmap);
+			size_type cardinality = 0;
+		};
+
+		struct run
+		{
+			low_type start;
+			// the run is [start, start + length]
+			low_type length;
+		};
+
+		struct run_container
+		{
+			// sorted and never adjacent
+			std::vector<run> runs;
+		};
+
+		using bucket_type = std::variant<array_container, bitmap_container, run_container>;
+
+		[[nodiscard]] constexpr static key_type key_of(const value_type value) noexcept { return static_cast<key_type>(value >> 16); }
+
+		[[nodiscard]] constexpr static low_type low_of(const value_type value) noexcept { return static_cast<low_type>(value); }
+
+		[[nodiscard]] constexpr static value_type value_of(const key_type key, const low_type low) noexcept { return (static_cast<value_type>(key) << 16) bitor low; }
+
+		[[nodiscard]] static size_type cardinality_of(const bucket_type& bucket) noexcept
+		{
+			if (const auto* array = std::get_if<array_container>(&bucket)) { return array->values.size(); }
+			if (const auto* bitmap = std::get_if<bitmap_container>(&bucket)) { return bitmap->cardinality; }
+
+			size_type total = 0;
+			for (const auto& r: std::get<run_container>(bucket).runs) { total += size_type{r.length} + 1; }
+			return total;
+		}
+
+		[[nodiscard]] static bool contains(const bucket_type& bucket, const low_type low) noexcept
+		{
+			if (const auto* array = std::get_if<array_container>(&bucket)) { return std::ranges::binary_search(array->values, low); }
+			if (const auto* bitmap = std::get_if<bitmap_container>(&bucket)) { return (bitmap->blocks[low / bits_of_block] >> (low % bits_of_block) bitand 1) not_eq 0; }
+
+			const auto& runs = std::get<run_container>(bucket).runs;
+			// the last run starts at or before low
+			auto it = std::ranges::upper_bound(runs, low, {}, &run::start);
+			if (it == runs.begin()) { return false; }
+			--it;
+			return static_cast<size_type>(low - it->start) <= it->length;
+		}
+
+		/**
+		 * @brief visit the low 16 bits of the values in the bucket (in ascending order)
+		*/
+		template<typename Function>
+		static void for_each_low(const bucket_type& bucket, Function&& function)
+		{
+			if (const auto* array = std::get_if<array_container>(&bucket)) { for (const auto low: array->values) { function(low); } }
+			else if (const auto* bitmap = std::get_if<bitmap_container>(&bucket))
+			{
+				for (size_type i = 0; i < blocks_of_bitmap; ++i)
+				{
+					for (auto block = bitmap->blocks[i]; block not_eq 0; block and_eq block - 1) { function(static_cast<low_type>(i * bits_of_block + static_cast<size_type>(std::countr_zero(block)))); }
+				}
+			}
+			else
+			{
+				for (const auto& r: std::get<run_container>(bucket).runs)
+				{
+					for (size_type low = r.start; low <= size_type{r.start} + r.length; ++low) { function(static_cast<low_type>(low)); }
+				}
+			}
+		}
+
+		/**
+		 * @brief set the bits [first, last] of the bitmap blocks
+		*/
+		static void fill_range(std::vector<block_type>& blocks, const size_type first, const size_type last) noexcept
+		{
+			const auto first_block = first / bits_of_block;
+			const auto last_block = last / bits_of_block;
+			const auto first_mask = compl block_type{0} << (first % bits_of_block);
+			const auto last_mask = compl block_type{0} >> (bits_of_block - 1 - last % bits_of_block);
+
+			if (first_block == last_block)
+			{
+				blocks[first_block] or_eq first_mask bitand last_mask;
+				return;
+			}
+
+			blocks[first_block] or_eq first_mask;
+			for (auto i = first_block + 1; i < last_block; ++i) { blocks[i] = compl block_type{0}; }
+			blocks[last_block] or_eq last_mask;
+		}
+
+		[[nodiscard]] static bitmap_container to_bitmap(const bucket_type& bucket)
+		{
+			if (const auto* bitmap = std::get_if<bitmap_container>(&bucket)) { return *bitmap; }
+
+			bitmap_container bitmap;
+			if (const auto* array = std::get_if<array_container>(&bucket))
+			{
+				for (const auto low: array->values) { bitmap.blocks[low / bits_of_block] or_eq block_type{1} << (low % bits_of_block); }
+			}
+			else { for (const auto& r: std::get<run_container>(bucket).runs) { fill_range(bitmap.blocks, r.start, size_type{r.start} + r.length); } }
+			bitmap.cardinality = cardinality_of(bucket);
+			return bitmap;
+		}
+
+		[[nodiscard]] static array_container to_array(const bucket_type& bucket)
+		{
+			if (const auto* array = std::get_if<array_container>(&bucket)) { return *array; }
+
+			array_container array;
+			array.values.reserve(cardinality_of(bucket));
+			for_each_low(bucket, [&array](const low_type low) { array.values.push_back(low); });
+			return array;
+		}
+
+		[[nodiscard]] static run_container to_run(const bucket_type& bucket)
+		{
+			if (const auto* runs = std::get_if<run_container>(&bucket)) { return *runs; }
+
+			run_container runs;
+			for_each_low(bucket,
+			             [&runs](const low_type low)
+			             {
+				             if (not runs.runs.empty() and size_type{runs.runs.back().start} + runs.runs.back().length + 1 == low) { ++runs.runs.back().length; }
+				             else { runs.runs.push_back({low, 0}); }
+			             });
+			return runs;
+		}
+
+		/**
+		 * @brief get the blocks of a bucket, only convert it (into storage) if it is not a bitmap
+		*/
+		[[nodiscard]] static const bitmap_container& as_bitmap(const bucket_type& bucket, std::optional<bitmap_container>& storage)
+		{
+			if (const auto* bitmap = std::get_if<bitmap_container>(&bucket)) { return *bitmap; }
+			return storage.emplace(to_bitmap(bucket));
+		}
+
+		/**
+		 * @brief pick the smaller one of array and bitmap for the cardinality (a run container only comes from run_optimize)
+		*/
+		[[nodiscard]] static bucket_type normalize(bucket_type bucket)
+		{
+			if (const auto cardinality = cardinality_of(bucket); cardinality <= array_max_cardinality)
+			{
+				if (not std::holds_alternative<array_container>(bucket)) { return to_array(bucket); }
+			}
+			else if (not std::holds_alternative<bitmap_container>(bucket)) { return to_bitmap(bucket); }
+			return bucket;
+		}
+
+		static void set_low(bucket_type& bucket, const low_type low)
+		{
+			if (std::holds_alternative<run_container>(bucket))
+			{
+				if (contains(bucket, low)) { return; }
+				bucket = normalize(std::move(bucket));
+			}
+
+			if (auto* array = std::get_if<array_container>(&bucket))
+			{
+				const auto it = std::ranges::lower_bound(array->values, low);
+				if (it not_eq array->values.end() and *it == low) { return; }
+				if (array->values.size() < array_max_cardinality)
+				{
+					array->values.insert(it, low);
+					return;
+				}
+				bucket = to_bitmap(bucket);
+			}
+
+			auto& bitmap = std::get<bitmap_container>(bucket);
+			auto& block = bitmap.blocks[low / bits_of_block];
+			if (const auto mask = block_type{1} << (low % bits_of_block); (block bitand mask) == 0)
+			{
+				block or_eq mask;
+				++bitmap.cardinality;
+			}
+		}
+
+		static void reset_low(bucket_type& bucket, const low_type low)
+		{
+			if (std::holds_alternative<run_container>(bucket))
+			{
+				if (not contains(bucket, low)) { return; }
+				bucket = normalize(std::move(bucket));
+			}
+
+			if (auto* array = std::get_if<array_container>(&bucket))
+			{
+				if (const auto it = std::ranges::lower_bound(array->values, low); it not_eq array->values.end() and *it == low) { array->values.erase(it); }
+				return;
+			}
+
+			auto& bitmap = std::get<bitmap_container>(bucket);
+			auto& block = bitmap.blocks[low / bits_of_block];
+			if (const auto mask = block_type{1} << (low % bits_of_block); (block bitand mask) not_eq 0)
+			{
+				block and_eq compl mask;
+				if (--bitmap.cardinality <= array_max_cardinality) { bucket = to_array(bucket); }
+			}
+		}
+
+		/**
+		 * @brief lhs op rhs of two buckets with the same key
+		*/
+		template<details::block_operation Operation>
+		[[nodiscard]] static bucket_type combine(const bucket_type& lhs, const bucket_type& rhs)
+		{
+			const auto* lhs_array = std::get_if<array_container>(&lhs);
+			const auto* rhs_array = std::get_if<array_container>(&rhs);
+
+			if (lhs_array and rhs_array)
+			{
+				array_container result;
+				auto out = std::back_inserter(result.values);
+				if constexpr (Operation == details::block_operation::bit_and) { std::ranges::set_intersection(lhs_array->values, rhs_array->values, out); }
+				else if constexpr (Operation == details::block_operation::bit_or) { std::ranges::set_union(lhs_array->values, rhs_array->values, out); }
+				else if constexpr (Operation == details::block_operation::bit_xor) { std::ranges::set_symmetric_difference(lhs_array->values, rhs_array->values, out); }
+				else { std::ranges::set_difference(lhs_array->values, rhs_array->values, out); }
+				return normalize(std::move(result));
+			}
+
+			// a small array against a big container, test its values instead of expanding it
+			if constexpr (Operation == details::block_operation::bit_and or Operation == details::block_operation::bit_and_not)
+			{
+				if (lhs_array)
+				{
+					constexpr bool keep_contained = Operation == details::block_operation::bit_and;
+
+					array_container result;
+					for (const auto low: lhs_array->values) { if (contains(rhs, low) == keep_contained) { result.values.push_back(low); } }
+					return result;
+				}
+			}
+			if constexpr (Operation == details::block_operation::bit_and)
+			{
+				if (rhs_array)
+				{
+					array_container result;
+					for (const auto low: rhs_array->values) { if (contains(lhs, low)) { result.values.push_back(low); } }
+					return result;
+				}
+			}
+
+			auto result = to_bitmap(lhs);
+			std::optional<bitmap_container> storage;
+			const auto& other = as_bitmap(rhs, storage);
+			details::transform<Operation>(result.blocks.data(), other.blocks.data(), blocks_of_bitmap);
+			result.cardinality = details::popcount(result.blocks.data(), blocks_of_bitmap);
+			return normalize(std::move(result));
+		}
+
+		[[nodiscard]] static bool is_subset(const bucket_type& lhs, const bucket_type& rhs)
+		{
+			if (cardinality_of(lhs) > cardinality_of(rhs)) { return false; }
+
+			if (const auto* lhs_array = std::get_if<array_container>(&lhs))
+			{
+				if (const auto* rhs_array = std::get_if<array_container>(&rhs)) { return std::ranges::includes(rhs_array->values, lhs_array->values); }
+				return std::ranges::all_of(lhs_array->values, [&rhs](const low_type low) { return contains(rhs, low); });
+			}
+
+			std::optional<bitmap_container> lhs_storage;
+			std::optional<bitmap_container> rhs_storage;
+			const auto& a = as_bitmap(lhs, lhs_storage);
+			const auto& b = as_bitmap(rhs, rhs_storage);
+			return not details::any<details::block_operation::bit_and_not>(a.blocks.data(), b.blocks.data(), blocks_of_bitmap);
+		}
+
+		[[nodiscard]] static bool is_intersect(const bucket_type& lhs, const bucket_type& rhs)
+		{
+			const auto* lhs_array = std::get_if<array_container>(&lhs);
+			const auto* rhs_array = std::get_if<array_container>(&rhs);
+
+			if (lhs_array and rhs_array)
+			{
+				for (auto a = lhs_array->values.begin(), b = rhs_array->values.begin(); a not_eq lhs_array->values.end() and b not_eq rhs_array->values.end();)
+				{
+					if (*a < *b) { ++a; }
+					else if (*b < *a) { ++b; }
+					else { return true; }
+				}
+				return false;
+			}
+			if (lhs_array) { return std::ranges::any_of(lhs_array->values, [&rhs](const low_type low) { return contains(rhs, low); }); }
+			if (rhs_array) { return std::ranges::any_of(rhs_array->values, [&lhs](const low_type low) { return contains(lhs, low); }); }
+
+			std::optional<bitmap_container> lhs_storage;
+			std::optional<bitmap_container> rhs_storage;
+			const auto& a = as_bitmap(lhs, lhs_storage);
+			const auto& b = as_bitmap(rhs, rhs_storage);
+			return details::any<details::block_operation::bit_and>(a.blocks.data(), b.blocks.data(), blocks_of_bitmap);
+		}
+
+		/**
+		 * @brief how many runs a bucket would need
+		*/
+		[[nodiscard]] static size_type runs_of(const bucket_type& bucket) noexcept
+		{
+			if (const auto* runs = std::get_if<run_container>(&bucket)) { return runs->runs.size(); }
+
+			size_type total = 0;
+			if (const auto* array = std::get_if<array_container>(&bucket))
+			{
+				for (size_type i = 0; i < array->values.size(); ++i) { if (i == 0 or array->values[i] not_eq array->values[i - 1] + 1) { ++total; } }
+				return total;
+			}
+
+			// a run starts at a set bit whose previous bit is not set
+			block_type carry = 0;
+			for (const auto block: std::get<bitmap_container>(bucket).blocks)
+			{
+				total += static_cast<size_type>(std::popcount(block bitand compl((block << 1) bitor carry)));
+				carry = block >> (bits_of_block - 1);
+			}
+			return total;
+		}
+
+		/**
+		 * @brief the heap memory of a bucket
+		*/
+		[[nodiscard]] static size_type memory_of(const bucket_type& bucket) noexcept
+		{
+			if (const auto* array = std::get_if<array_container>(&bucket)) { return array->values.capacity() * sizeof(low_type); }
+			if (const auto* bitmap = std::get_if<bitmap_container>(&bucket)) { return bitmap->blocks.capacity() * sizeof(block_type); }
+			return std::get<run_container>(bucket).runs.capacity() * sizeof(run);
+		}
+
+		/**
+		 * @brief merge the buckets of other into self, a bucket only in self / only in other is kept if KeepLhsOnly / KeepRhsOnly
+		*/
+		template<details::block_operation Operation, bool KeepLhsOnly, bool KeepRhsOnly>
+		void merge(const roaring_bitset& other)
+		{
+			std::vector<key_type> keys;
+			std::vector<bucket_type> buckets;
+			keys.reserve(keys_.size() + (KeepRhsOnly ? other.keys_.size() : 0));
+			buckets.reserve(keys.capacity());
+
+			const auto push = [&keys, &buckets](const key_type key, bucket_type&& bucket)
+			{
+				keys.push_back(key);
+				buckets.push_back(std::move(bucket));
+			};
+
+			size_type i = 0;
+			size_type j = 0;
+			while (i < keys_.size() or j < other.keys_.size())
+			{
+				if (j == other.keys_.size() or (i < keys_.size() and keys_[i] < other.keys_[j]))
+				{
+					if constexpr (KeepLhsOnly) { push(keys_[i], std::move(buckets_[i])); }
+					++i;
+				}
+				else if (i == keys_.size() or other.keys_[j] < keys_[i])
+				{
+					if constexpr (KeepRhsOnly) { push(other.keys_[j], bucket_type{other.buckets_[j]}); }
+					++j;
+				}
+				else
+				{
+					if (auto bucket = combine<Operation>(buckets_[i], other.buckets_[j]); cardinality_of(bucket) not_eq 0) { push(keys_[i], std::move(bucket)); }
+					++i;
+					++j;
+				}
+			}
+
+			keys_ = std::move(keys);
+			buckets_ = std::move(buckets);
+		}
+
+		/**
+		 * @brief find the bucket of key
+		 * @return index of bucket or keys_.size()
+		*/
+		[[nodiscard]] size_type find_bucket(const key_type key) const noexcept
+		{
+			const auto it = std::ranges::lower_bound(keys_, key);
+			if (it == keys_.end() or *it not_eq key) { return keys_.size(); }
+			return static_cast<size_type>(it - keys_.begin());
+		}
+
+	public:
+		/**
+		 * @brief default ctor
+		 */
+		roaring_bitset() noexcept = default;
+
+		/**
+		 * @brief ctor from values
+		 * @param values values to set
+		 */
+		roaring_bitset(std::initializer_list<value_type> values)
+		{
+			for (const auto value: values) { set(value); }
+		}
+
+		/**
+		 * @brief ctor from a dense bitset
+		 * @param bitset bitset (at most 2^32 bits)
+		 */
+		explicit roaring_bitset(const basic_dynamic_bitset& bitset)
+		{
+			gal_assert(bitset.size() <= size_type{1} << 32, "the bitset is bigger than the universe of roaring_bitset");
+
+			// the set bits come in ascending order, so only the last bucket can change
+			for (const auto pos: bitset.set_bits())
+			{
+				const auto value = static_cast<value_type>(pos);
+				if (keys_.empty() or keys_.back() not_eq key_of(value))
+				{
+					keys_.push_back(key_of(value));
+					buckets_.emplace_back();
+				}
+				set_low(buckets_.back(), low_of(value));
+			}
+		}
+
+		/**
+		 * @brief convert to a dense bitset
+		 * @param size how many bits the bitset holds (must be greater than max())
+		 * @return bitset
+		 */
+		[[nodiscard]] basic_dynamic_bitset to_dynamic_bitset(const size_type size) const
+		{
+			gal_assert(empty() or max() < size, "the bitset cannot hold all values");
+
+			basic_dynamic_bitset bitset(size);
+			for_each([&bitset](const value_type value) { bitset.set(value); });
+			return bitset;
+		}
+
+		/**
+		 * @brief convert to a dense bitset that just holds max()
+		 * @return bitset
+		 */
+		[[nodiscard]] basic_dynamic_bitset to_dynamic_bitset() const { return to_dynamic_bitset(empty() ? 0 : size_type{max()} + 1); }
+
+		/**
+		 * @brief how many values we hold
+		 * @return count
+		 */
+		[[nodiscard]] size_type count() const noexcept
+		{
+			size_type total = 0;
+			for (const auto& bucket: buckets_) { total += cardinality_of(bucket); }
+			return total;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+
+		[[nodiscard]] bool any() const noexcept { return not empty(); }
+
+		[[nodiscard]] bool none() const noexcept { return empty(); }
+
+		/**
+		 * @brief how many (non-empty) buckets we have
+		 * @return buckets
+		 */
+		[[nodiscard]] size_type bucket_size() const noexcept { return keys_.size(); }
+
+		/**
+		 * @brief check a value
+		 * @param value value
+		 * @return is it set
+		 */
+		[[nodiscard]] bool test(const value_type value) const noexcept
+		{
+			const auto index = find_bucket(key_of(value));
+			return index not_eq keys_.size() and contains(buckets_[index], low_of(value));
+		}
+
+		/**
+		 * @brief set a value
+		 * @param value value
+		 * @param set set or reset
+		 * @return self
+		 */
+		roaring_bitset& set(const value_type value, const bool set = true)
+		{
+			if (not set) { return reset(value); }
+
+			const auto it = std::ranges::lower_bound(keys_, key_of(value));
+			const auto index = static_cast<size_type>(it - keys_.begin());
+			if (it == keys_.end() or *it not_eq key_of(value))
+			{
+				keys_.insert(it, key_of(value));
+				buckets_.emplace(buckets_.begin() + static_cast<std::ptrdiff_t>(index));
+			}
+			set_low(buckets_[index], low_of(value));
+			return *this;
+		}
+
+		/**
+		 * @brief reset a value
+		 * @param value value
+		 * @return self
+		 */
+		roaring_bitset& reset(const value_type value)
+		{
+			if (const auto index = find_bucket(key_of(value)); index not_eq keys_.size())
+			{
+				reset_low(buckets_[index], low_of(value));
+				if (cardinality_of(buckets_[index]) == 0)
+				{
+					keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(index));
+					buckets_.erase(buckets_.begin() + static_cast<std::ptrdiff_t>(index));
+				}
+			}
+			return *this;
+		}
+
+		/**
+		 * @brief flip a value
+		 * @param value value
+		 * @return self
+		 */
+		roaring_bitset& flip(const value_type value) { return set(value, not test(value)); }
+
+		/**
+		 * @brief reset all values
+		 */
+		void clear() noexcept
+		{
+			keys_.clear();
+			buckets_.clear();
+		}
+
+		/**
+		 * @brief get the smallest value
+		 * @return value
+		 */
+		[[nodiscard]] value_type min() const
+		{
+			gal_assert(not empty(), "empty bitset");
+
+			const auto& bucket = buckets_.front();
+			if (const auto* array = std::get_if<array_container>(&bucket)) { return value_of(keys_.front(), array->values.front()); }
+			if (const auto* runs = std::get_if<run_container>(&bucket)) { return value_of(keys_.front(), runs->runs.front().start); }
+
+			const auto& blocks = std::get<bitmap_container>(bucket).blocks;
+			size_type i = 0;
+			while (blocks[i] == 0) { ++i; }
+			return value_of(keys_.front(), static_cast<low_type>(i * bits_of_block + static_cast<size_type>(std::countr_zero(blocks[i]))));
+		}
+
+		/**
+		 * @brief get the biggest value
+		 * @return value
+		 */
+		[[nodiscard]] value_type max() const
+		{
+			gal_assert(not empty(), "empty bitset");
+
+			const auto& bucket = buckets_.back();
+			if (const auto* array = std::get_if<array_container>(&bucket)) { return value_of(keys_.back(), array->values.back()); }
+			if (const auto* runs = std::get_if<run_container>(&bucket)) { return value_of(keys_.back(), static_cast<low_type>(runs->runs.back().start + runs->runs.back().length)); }
+
+			const auto& blocks = std::get<bitmap_container>(bucket).blocks;
+			size_type i = blocks_of_bitmap;
+			while (blocks[--i] == 0) { }
+			return value_of(keys_.back(), static_cast<low_type>(i * bits_of_block + bits_of_block - 1 - static_cast<size_type>(std::countl_zero(blocks[i]))));
+		}
+
+		/**
+		 * @brief visit all values in ascending order
+		 * @tparam Function function type
+		 * @param function function accept a value_type
+		 */
+		template<typename Function>
+			requires std::is_invocable_v<Function, value_type>
+		void for_each(Function&& function) const
+		{
+			for (size_type i = 0; i < keys_.size(); ++i) { for_each_low(buckets_[i], [&](const low_type low) { function(value_of(keys_[i], low)); }); }
+		}
+
+		/**
+		 * @brief and_eq with another roaring_bitset, get all values' intersection set
+		 * @param other another roaring_bitset
+		 * @return self
+		 */
+		roaring_bitset& operator and_eq(const roaring_bitset& other)
+		{
+			merge<details::block_operation::bit_and, false, false>(other);
+			return *this;
+		}
+
+		/**
+		 * @brief or_eq with another roaring_bitset, get all values' union set
+		 * @param other another roaring_bitset
+		 * @return self
+		 */
+		roaring_bitset& operator or_eq(const roaring_bitset& other)
+		{
+			merge<details::block_operation::bit_or, true, true>(other);
+			return *this;
+		}
+
+		/**
+		 * @brief xor_eq with another roaring_bitset, get all values' symmetric
+		 * @param other another roaring_bitset
+		 * @return self
+		 */
+		roaring_bitset& operator xor_eq(const roaring_bitset& other)
+		{
+			merge<details::block_operation::bit_xor, true, true>(other);
+			return *this;
+		}
+
+		/**
+		 * @brief -= with another roaring_bitset, get all values' subtraction set
+		 * @param other another roaring_bitset
+		 * @return self
+		 */
+		roaring_bitset& operator-=(const roaring_bitset& other)
+		{
+			merge<details::block_operation::bit_and_not, true, false>(other);
+			return *this;
+		}
+
+		[[nodiscard]] friend roaring_bitset operator bitand(roaring_bitset lhs, const roaring_bitset& rhs) { return lhs and_eq rhs; }
+
+		[[nodiscard]] friend roaring_bitset operator bitor(roaring_bitset lhs, const roaring_bitset& rhs) { return lhs or_eq rhs; }
+
+		[[nodiscard]] friend roaring_bitset operator xor(roaring_bitset lhs, const roaring_bitset& rhs) { return lhs xor_eq rhs; }
+
+		[[nodiscard]] friend roaring_bitset operator-(roaring_bitset lhs, const roaring_bitset& rhs) { return lhs -= rhs; }
+
+		/**
+		 * @brief is self is a subset of other ? (all values of self also in other, but `maybe` other has more values)
+		 * @param other another roaring_bitset
+		 * @return result
+		 */
+		[[nodiscard]] bool is_subset_of(const roaring_bitset& other) const
+		{
+			size_type j = 0;
+			for (size_type i = 0; i < keys_.size(); ++i)
+			{
+				while (j < other.keys_.size() and other.keys_[j] < keys_[i]) { ++j; }
+				if (j == other.keys_.size() or other.keys_[j] not_eq keys_[i] or not is_subset(buckets_[i], other.buckets_[j])) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * @brief is self is a subset of other ? (all values of self also in other, but other has more values)
+		 * @param other another roaring_bitset
+		 * @return result
+		 */
+		[[nodiscard]] bool is_proper_subset_of(const roaring_bitset& other) const { return is_subset_of(other) and count() < other.count(); }
+
+		/**
+		 * @brief is there any value in both self and other ?
+		 * @param other another roaring_bitset
+		 * @return result
+		 */
+		[[nodiscard]] bool is_intersects(const roaring_bitset& other) const
+		{
+			for (size_type i = 0, j = 0; i < keys_.size() and j < other.keys_.size();)
+			{
+				if (keys_[i] < other.keys_[j]) { ++i; }
+				else if (other.keys_[j] < keys_[i]) { ++j; }
+				else
+				{
+					if (is_intersect(buckets_[i], other.buckets_[j])) { return true; }
+					++i;
+					++j;
+				}
+			}
+			return false;
+		}
+
+		/**
+		 * @brief do the two bitsets hold the same values ? (no matter which containers they use)
+		 * @param other another roaring_bitset
+		 * @return result
+		 */
+		[[nodiscard]] bool operator==(const roaring_bitset& other) const
+		{
+			if (keys_ not_eq other.keys_) { return false; }
+			for (size_type i = 0; i < keys_.size(); ++i)
+			{
+				if (cardinality_of(buckets_[i]) not_eq cardinality_of(other.buckets_[i]) or not is_subset(buckets_[i], other.buckets_[i])) { return false; }
+			}
+			return true;
+		}
+
+		/**
+		 * @brief convert every bucket to the smallest container, including the run container
+		 * @return is any bucket converted
+		 * @note call it after the bitset is built, modifying a run container converts it back to an array or a bitmap
+		 */
+		bool run_optimize()
+		{
+			bool converted = false;
+			for (auto& bucket: buckets_)
+			{
+				const auto cardinality = cardinality_of(bucket);
+				const auto run_bytes = runs_of(bucket) * sizeof(run);
+				const auto other_bytes = cardinality <= array_max_cardinality ? cardinality * sizeof(low_type) : blocks_of_bitmap * sizeof(block_type);
+
+				if (run_bytes < other_bytes)
+				{
+					if (std::holds_alternative<run_container>(bucket)) { continue; }
+					bucket = to_run(bucket);
+				}
+				else
+				{
+					if (not std::holds_alternative<run_container>(bucket)) { continue; }
+					bucket = normalize(std::move(bucket));
+				}
+				converted = true;
+			}
+			return converted;
+		}
+
+		/**
+		 * @brief release the unused capacity of the buckets
+		 */
+		void shrink_to_fit()
+		{
+			keys_.shrink_to_fit();
+			buckets_.shrink_to_fit();
+			for (auto& bucket: buckets_)
+			{
+				if (auto* array = std::get_if<array_container>(&bucket)) { array->values.shrink_to_fit(); }
+				else if (auto* runs = std::get_if<run_container>(&bucket)) { runs->runs.shrink_to_fit(); }
+			}
+		}
+
+		/**
+		 * @brief get the memory we use (include the heap memory)
+		 * @return bytes
+		 */
+		[[nodiscard]] size_type memory_usage() const noexcept
+		{
+			size_type total = sizeof(*this) + keys_.capacity() * sizeof(key_type) + buckets_.capacity() * sizeof(bucket_type);
+			for (const auto& bucket: buckets_) { total += memory_of(bucket); }
+			return total;
+		}
+
+	private:
+		// sorted
+		std::vector<key_type> keys_;
+		// buckets_[i] holds the values whose high 16 bits are keys_[i], never empty
+		std::vector<bucket_type> buckets_;
+	};
+}// namespace gal::toolbox::container
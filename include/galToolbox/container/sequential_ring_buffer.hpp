@@ -0,0 +1,271 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <galToolbox/utils/assert.hpp>
+
+namespace gal::toolbox::container
+{
+	/**
+	 * @brief a ring buffer with a fixed capacity whose elements are always stored sequentially (push at back and pop at front)
+	 * @tparam T value type
+	 * @tparam Size capacity (must be 2^n)
+	 * @tparam Alloc allocator type
+	 * @note unlike ring_buffer, the occupancy is derived from the head/tail counters instead of a bitset,
+	 * so size/full/empty are O(1) and a write only touches the element's own memory
+	*/
+	template<typename T, std::size_t Size, typename Alloc = std::allocator<T>>
+	class sequential_ring_buffer
+	{
+	public:
+		using allocator_type = Alloc;
+		using allocator_trait_type = std::allocator_traits<allocator_type>;
+
+		using value_type = typename allocator_type::value_type;
+		using size_type = typename allocator_type::size_type;
+
+		constexpr static size_type max_size = Size;
+		constexpr static size_type mask = max_size - 1;
+		static_assert((max_size & mask) == 0, "capacity must be 2^n");
+
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+		// a range of the buffer is at most split into two segments (the second one is empty if it does not wrap around)
+		using spans_type = std::array<std::span<value_type>, 2>;
+		using const_spans_type = std::array<std::span<const value_type>, 2>;
+
+		constexpr sequential_ring_buffer()
+			: buffer_(allocator_trait_type::allocate(allocator_, max_size)) {}
+
+		constexpr ~sequential_ring_buffer() noexcept(std::is_nothrow_destructible_v<value_type>)
+		{
+			if (buffer_ == nullptr) { return; }
+
+			clear();
+			allocator_trait_type::deallocate(allocator_, buffer_, max_size);
+			buffer_ = nullptr;
+		}
+
+		template<std::convertible_to<value_type> U, std::size_t N, typename Allocator>
+		constexpr explicit sequential_ring_buffer(const sequential_ring_buffer<U, N, Allocator>& other)
+			: sequential_ring_buffer() { paste(other); }
+
+		constexpr sequential_ring_buffer(const sequential_ring_buffer& other)
+			: sequential_ring_buffer() { paste(other); }
+
+		constexpr sequential_ring_buffer& operator=(const sequential_ring_buffer& other)
+		{
+			if (std::addressof(other) == this) { return *this; }
+
+			clear();
+			paste(other);
+
+			return *this;
+		}
+
+		constexpr sequential_ring_buffer(sequential_ring_buffer&& other) noexcept
+			: buffer_(std::exchange(other.buffer_, nullptr)),
+			  head_(std::exchange(other.head_, 0)),
+			  tail_(std::exchange(other.tail_, 0)) {}
+
+		constexpr sequential_ring_buffer& operator=(sequential_ring_buffer&& other) noexcept
+		{
+			if (std::addressof(other) == this) { return *this; }
+
+			if (buffer_ != nullptr)
+			{
+				clear();
+				allocator_trait_type::deallocate(allocator_, buffer_, max_size);
+			}
+
+			buffer_ = std::exchange(other.buffer_, nullptr);
+			head_ = std::exchange(other.head_, 0);
+			tail_ = std::exchange(other.tail_, 0);
+			return *this;
+		}
+
+		[[nodiscard]] constexpr size_type size() const noexcept { return tail_ - head_; }
+
+		[[nodiscard]] constexpr bool empty() const noexcept { return head_ == tail_; }
+
+		[[nodiscard]] constexpr bool full() const noexcept { return size() == max_size; }
+
+		/**
+		 * @brief get where the pos actually in
+		 * @param pos given pos
+		 * @return actually index
+		*/
+		[[nodiscard]] constexpr size_type index_of(size_type pos) const noexcept { return pos bitand mask; }
+
+		/**
+		 * @brief get the i-th element's reference (counting from the front)
+		 * @param index element's index
+		 * @return reference
+		*/
+		GAL_ASSERT_CONSTEXPR reference operator[](size_type index) noexcept
+		{
+			gal_assert(index < size(), "index out of range");
+			return buffer_[index_of(head_ + index)];
+		}
+
+		/**
+		 * @brief get the i-th element's reference (counting from the front)
+		 * @param index element's index
+		 * @return const_reference
+		*/
+		GAL_ASSERT_CONSTEXPR const_reference operator[](size_type index) const noexcept
+		{
+			gal_assert(index < size(), "index out of range");
+			return buffer_[index_of(head_ + index)];
+		}
+
+		GAL_ASSERT_CONSTEXPR reference front() noexcept { return this->operator[](0); }
+
+		GAL_ASSERT_CONSTEXPR const_reference front() const noexcept { return this->operator[](0); }
+
+		GAL_ASSERT_CONSTEXPR reference back() noexcept { return this->operator[](size() - 1); }
+
+		GAL_ASSERT_CONSTEXPR const_reference back() const noexcept { return this->operator[](size() - 1); }
+
+		/**
+		 * @brief construct a new element at the back
+		 * @param args args
+		 * @return push result (false if the buffer is full)
+		*/
+		template<typename... Args>
+		constexpr bool push(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args...>)
+		{
+			if (full()) { return false; }
+
+			allocator_trait_type::construct(allocator_, buffer_ + index_of(tail_), value_type{std::forward<Args>(args)...});
+			++tail_;
+			return true;
+		}
+
+		/**
+		 * @brief move the front element out and destroy it
+		 * @param data a reference to receive data
+		 * @return pop result (false if the buffer is empty)
+		*/
+		constexpr bool pop(reference data) noexcept(std::is_nothrow_move_assignable_v<value_type>)
+		{
+			if (empty()) { return false; }
+
+			data = std::move(front());
+			return pop();
+		}
+
+		/**
+		 * @brief destroy the front element
+		 * @return pop result (false if the buffer is empty)
+		*/
+		constexpr bool pop() noexcept
+		{
+			if (empty()) { return false; }
+
+			allocator_trait_type::destroy(allocator_, buffer_ + index_of(head_));
+			++head_;
+			return true;
+		}
+
+		/**
+		 * @brief get the memory of all elements (from front to back)
+		 * @return up to two segments
+		*/
+		[[nodiscard]] constexpr spans_type readable_spans() noexcept { return split(buffer_, head_, size()); }
+
+		/**
+		 * @brief get the memory of all elements (from front to back)
+		 * @return up to two segments
+		*/
+		[[nodiscard]] constexpr const_spans_type readable_spans() const noexcept { return split(static_cast<const_pointer>(buffer_), head_, size()); }
+
+		/**
+		 * @brief get the raw memory after the back element, write into it and then `commit` it
+		 * @return up to two segments
+		*/
+		[[nodiscard]] constexpr spans_type writable_spans() noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			return split(buffer_, tail_, max_size - size());
+		}
+
+		/**
+		 * @brief append n elements to the back (after writing into the memory returned by `writable_spans`)
+		 * @param n how many elements
+		*/
+		GAL_ASSERT_CONSTEXPR void commit(const size_type n) noexcept
+			requires std::is_trivially_copyable_v<value_type>
+		{
+			gal_assert(n <= max_size - size(), "commit more elements than the available space");
+			tail_ += n;
+		}
+
+		/**
+		 * @brief remove n elements from the front (after reading from the memory returned by `readable_spans`)
+		 * @param n how many elements
+		*/
+		GAL_ASSERT_CONSTEXPR void consume(const size_type n) noexcept
+		{
+			gal_assert(n <= size(), "consume more elements than exist");
+			if constexpr (std::is_trivially_destructible_v<value_type>) { head_ += n; }
+			else { for (size_type i = 0; i < n; ++i) { pop(); } }
+		}
+
+		/**
+		 * @brief destroy all elements
+		*/
+		constexpr void clear() noexcept
+		{
+			if constexpr (not std::is_trivially_destructible_v<value_type>)
+			{
+				for (; head_ != tail_; ++head_) { allocator_trait_type::destroy(allocator_, buffer_ + index_of(head_)); }
+			}
+			head_ = tail_ = 0;
+		}
+
+		/**
+		 * @brief paste another sequential_ring_buffer's elements to the back of this sequential_ring_buffer
+		 * @note stop when this buffer is full
+		*/
+		template<std::convertible_to<value_type> U, std::size_t N, typename Allocator>
+		constexpr void paste(const sequential_ring_buffer<U, N, Allocator>& other)
+		{
+			for (size_type i = 0; i < other.size() and not full(); ++i) { this->push(static_cast<value_type>(other[i])); }
+		}
+
+	private:
+		template<typename Value>
+		[[nodiscard]] constexpr static std::array<std::span<Value>, 2> split(Value* buffer, const size_type begin, const size_type n) noexcept
+		{
+			const auto index = begin bitand mask;
+			const auto first = std::min(n, max_size - index);
+			return {std::span<Value>{buffer + index, first}, std::span<Value>{buffer, n - first}};
+		}
+
+		[[no_unique_address]] allocator_type allocator_;
+		pointer buffer_;
+		// head_ and tail_ only increase, index_of maps them into buffer
+		size_type head_{0};
+		size_type tail_{0};
+	};
+
+	template<typename U1, std::size_t S1, typename Allocator1, std::convertible_to<U1> U2, std::size_t S2, typename Allocator2>
+	constexpr bool operator==(const sequential_ring_buffer<U1, S1, Allocator1>& lhs,
+	                          const sequential_ring_buffer<U2, S2, Allocator2>& rhs)
+	{
+		if (lhs.size() != rhs.size()) { return false; }
+
+		for (std::size_t i = 0; i < lhs.size(); ++i) { if (not(lhs[i] == rhs[i])) { return false; } }
+
+		return true;
+	}
+}// namespace gal::toolbox::container
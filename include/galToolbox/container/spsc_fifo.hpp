@@ -0,0 +1,208 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+#include <galToolbox/utils/cache_line.hpp>
+
+namespace gal::toolbox::container
+{
+	/**
+	 * @brief a single-producer/single-consumer fifo with a fixed capacity
+	 * @tparam T value type
+	 * @tparam N capacity (must be 2^n)
+	 * @tparam Alloc allocator type
+	 * @tparam IsBlocking whether the consumer may wait for data with pop (opt-in slow path)
+	 * @note exactly one thread may push and exactly one thread may pop at the same time,
+	 * push/try_pop only use acquire/release on the producer/consumer indices (which live on separate cache lines),
+	 * only a blocking fifo has the mutex and condition_variable (and the fence in push that pairs with a sleeping consumer),
+	 * a non-blocking fifo pays nothing for them
+	*/
+	template<typename T, std::size_t N, typename Alloc = std::allocator<T>, bool IsBlocking = false>
+	class spsc_fifo
+	{
+	public:
+		using allocator_type = Alloc;
+		using allocator_trait_type = std::allocator_traits<allocator_type>;
+
+		using value_type = typename allocator_type::value_type;
+		using size_type = typename allocator_type::size_type;
+
+		constexpr static size_type max_size = N;
+		constexpr static size_type mask = max_size - 1;
+		static_assert((max_size & mask) == 0, "capacity must be 2^n");
+
+		constexpr static bool is_blocking = IsBlocking;
+
+		using time_type = size_type;
+
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+
+		spsc_fifo()
+			: buffer_(allocator_trait_type::allocate(allocator_, max_size)) {}
+
+		spsc_fifo(const spsc_fifo&) = delete;
+		spsc_fifo& operator=(const spsc_fifo&) = delete;
+		spsc_fifo(spsc_fifo&&) = delete;
+		spsc_fifo& operator=(spsc_fifo&&) = delete;
+
+		~spsc_fifo() noexcept(std::is_nothrow_destructible_v<value_type>)
+		{
+			if constexpr (not std::is_trivially_destructible_v<value_type>)
+			{
+				for (auto i = consumer_.load(std::memory_order_relaxed), end = producer_.load(std::memory_order_relaxed); i != end; ++i)
+				{
+					allocator_trait_type::destroy(allocator_, buffer_ + (i bitand mask));
+				}
+			}
+
+			allocator_trait_type::deallocate(allocator_, buffer_, max_size);
+			buffer_ = nullptr;
+		}
+
+		/**
+		 * @brief get the size of the currently existing data
+		 * @return size
+		 * @note only a snapshot if the other side is working at the same time
+		*/
+		[[nodiscard]] size_type size() const noexcept { return producer_.load(std::memory_order_acquire) - consumer_.load(std::memory_order_acquire); }
+
+		[[nodiscard]] bool full() const noexcept { return size() == max_size; }
+
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+		/**
+		 * @brief push a new data into fifo (producer thread only)
+		 * @tparam Args args' type
+		 * @param args the parameters must be constructable into the value_type
+		 * @return push result
+		*/
+		template<typename... Args>
+		bool push(Args&&... args) noexcept(std::is_nothrow_constructible_v<value_type, Args...>)
+		{
+			const auto producer = producer_.load(std::memory_order_relaxed);
+			if (producer - cached_consumer_ == max_size)
+			{
+				// only refresh the consumer's index when our cached one says full
+				cached_consumer_ = consumer_.load(std::memory_order_acquire);
+				if (producer - cached_consumer_ == max_size) { return false; }
+			}
+
+			allocator_trait_type::construct(allocator_, buffer_ + (producer bitand mask), value_type{std::forward<Args>(args)...});
+			producer_.store(producer + 1, std::memory_order_release);
+
+			if constexpr (is_blocking) { wake_consumer(); }
+			return true;
+		}
+
+		/**
+		 * @brief pop a data from fifo without waiting (consumer thread only)
+		 * @param data a reference to receive data
+		 * @return pop success or not
+		*/
+		bool try_pop(reference data) noexcept(std::is_nothrow_move_assignable_v<value_type>)
+		{
+			const auto consumer = consumer_.load(std::memory_order_relaxed);
+			if (consumer == cached_producer_)
+			{
+				// only refresh the producer's index when our cached one says empty
+				cached_producer_ = producer_.load(std::memory_order_acquire);
+				if (consumer == cached_producer_) { return false; }
+			}
+
+			const auto p = buffer_ + (consumer bitand mask);
+			data = std::move(*p);
+			allocator_trait_type::destroy(allocator_, p);
+			consumer_.store(consumer + 1, std::memory_order_release);
+			return true;
+		}
+
+		/**
+		 * @brief pop a data from fifo (consumer thread only, blocking fifo only)
+		 * @param data a reference to receive data
+		 * @param wait_milliseconds_time maximum time willing to wait (milliseconds)
+		 * time == -1 means you are not willing to wait, if nothing to pop, return false
+		 * time == 0  means you have enough patience to wait for a necessary data
+		 * otherwise, wait for the given time, if there is still no data, return false
+		 * @return pop success or not
+		*/
+		bool pop(reference data, time_type wait_milliseconds_time = 0)
+			requires is_blocking
+		{
+			if (try_pop(data)) { return true; }
+			if (wait_milliseconds_time == static_cast<time_type>(-1)) { return false; }
+
+			{
+				std::unique_lock lock(slow_.mutex);
+
+				slow_.sleeping.store(true, std::memory_order_relaxed);
+				// pair with the fence in wake_consumer, either we see the new producer index or the producer sees us sleeping
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				const auto ready = [this] { return producer_.load(std::memory_order_relaxed) != consumer_.load(std::memory_order_relaxed); };
+				if (wait_milliseconds_time == 0) { slow_.cond.wait(lock, ready); }
+				else { slow_.cond.wait_for(lock, std::chrono::milliseconds(wait_milliseconds_time), ready); }
+
+				slow_.sleeping.store(false, std::memory_order_relaxed);
+			}
+
+			return try_pop(data);
+		}
+
+		/**
+		 * @brief pop a data from fifo but ignore what is popped (consumer thread only, blocking fifo only)
+		 * @param wait_milliseconds_time maximum time willing to wait (milliseconds)
+		 * for more detail, see `pop` with two arguments
+		 * @return pop success or not
+		*/
+		bool pop(time_type wait_milliseconds_time = 0)
+			requires is_blocking and std::is_default_constructible_v<value_type>
+		{
+			value_type dummy{};
+			return pop(dummy, wait_milliseconds_time);
+		}
+
+	private:
+		struct blocking_state
+		{
+			alignas(utils::cache_line_size) std::atomic<bool> sleeping{false};
+			std::mutex mutex;
+			std::condition_variable cond;
+		};
+
+		struct non_blocking_state {};
+
+		void wake_consumer()
+		{
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (slow_.sleeping.load(std::memory_order_relaxed))
+			{
+				// the consumer checks the producer index under the lock, so it is either not waiting yet or will receive this notification
+				{ std::scoped_lock lock(slow_.mutex); }
+				slow_.cond.notify_one();
+			}
+		}
+
+		// shared, read only
+		[[no_unique_address]] allocator_type allocator_;
+		pointer buffer_;
+
+		// written by producer
+		alignas(utils::cache_line_size) std::atomic<size_type> producer_{0};
+		size_type cached_consumer_{0};
+
+		// written by consumer
+		alignas(utils::cache_line_size) std::atomic<size_type> consumer_{0};
+		size_type cached_producer_{0};
+
+		// slow path (blocking fifo only)
+		[[no_unique_address]] std::conditional_t<is_blocking, blocking_state, non_blocking_state> slow_;
+	};
+}// namespace gal::toolbox::container
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <galToolbox/utils/cache_line.hpp>
+
+namespace gal::toolbox::container
+{
+	/**
+	 * @brief a Chase-Lev work-stealing deque with a growable capacity
+	 * @tparam T value type (must be trivially copyable, usually a pointer to a task)
+	 * @note the owner thread pushes/pops at the bottom (LIFO, keeps the cache warm),
+	 * any other thread can steal from the top (FIFO, takes the oldest and usually the biggest work),
+	 * the owner and the thieves only contend when there is one element left
+	*/
+	template<typename T>
+		requires std::is_trivially_copyable_v<T>
+	class work_stealing_deque
+	{
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+		// bottom - 1 may be negative when the owner pops an empty deque
+		using index_type = std::int64_t;
+
+		using reference = value_type&;
+		using const_reference = const value_type&;
+
+		constexpr static size_type default_capacity = 64;
+
+	private:
+		/**
+		 * @brief the circular array, indexed like ring_buffer (capacity is 2^n, index & mask)
+		 * @note the elements are atomic because a thief may read a slot while the owner overwrites it (the thief's CAS on top will fail then)
+		*/
+		class circular_array
+		{
+		public:
+			explicit circular_array(const size_type capacity)
+				: mask_(capacity - 1),
+				  data_(std::make_unique<std::atomic<value_type>[]>(capacity)) {}
+
+			[[nodiscard]] size_type capacity() const noexcept { return mask_ + 1; }
+
+			[[nodiscard]] value_type load(const index_type index) const noexcept { return data_[static_cast<size_type>(index) bitand mask_].load(std::memory_order_relaxed); }
+
+			void store(const index_type index, const value_type value) noexcept { data_[static_cast<size_type>(index) bitand mask_].store(value, std::memory_order_relaxed); }
+
+			/**
+			 * @brief copy the elements between top and bottom into a new array with twice the capacity
+			*/
+			[[nodiscard]] std::unique_ptr<circular_array> grow(const index_type top, const index_type bottom) const
+			{
+				auto array = std::make_unique<circular_array>(capacity() * 2);
+				for (auto i = top; i != bottom; ++i) { array->store(i, load(i)); }
+				return array;
+			}
+
+		private:
+			size_type mask_;
+			std::unique_ptr<std::atomic<value_type>[]> data_;
+		};
+
+	public:
+		/**
+		 * @brief construct a deque
+		 * @param capacity the initial capacity (will be rounded up to 2^n)
+		*/
+		explicit work_stealing_deque(const size_type capacity = default_capacity)
+		{
+			auto array = std::make_unique<circular_array>(std::bit_ceil(capacity < 2 ? 2 : capacity));
+			array_.store(array.get(), std::memory_order_relaxed);
+			arrays_.push_back(std::move(array));
+		}
+
+		work_stealing_deque(const work_stealing_deque&) = delete;
+		work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+		work_stealing_deque(work_stealing_deque&&) = delete;
+		work_stealing_deque& operator=(work_stealing_deque&&) = delete;
+
+		~work_stealing_deque() noexcept = default;
+
+		/**
+		 * @brief get the size of the currently existing data
+		 * @return size
+		 * @note only a snapshot if other threads are working at the same time
+		*/
+		[[nodiscard]] size_type size() const noexcept
+		{
+			const auto bottom = bottom_.load(std::memory_order_relaxed);
+			const auto top = top_.load(std::memory_order_relaxed);
+			return bottom > top ? static_cast<size_type>(bottom - top) : 0;
+		}
+
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+		/**
+		 * @brief get the current capacity
+		 * @return capacity
+		 * @note only the owner thread should call it
+		*/
+		[[nodiscard]] size_type capacity() const noexcept { return array_.load(std::memory_order_relaxed)->capacity(); }
+
+		/**
+		 * @brief push a new data at the bottom (owner thread only), grow the capacity if it is full
+		 * @param data data
+		*/
+		void push(const value_type data)
+		{
+			const auto bottom = bottom_.load(std::memory_order_relaxed);
+			const auto top = top_.load(std::memory_order_acquire);
+			auto* array = array_.load(std::memory_order_relaxed);
+
+			if (bottom - top > static_cast<index_type>(array->capacity()) - 1)
+			{
+				// the thieves may still be reading the old array, keep it alive until we are destroyed
+				arrays_.push_back(array->grow(top, bottom));
+				array = arrays_.back().get();
+				array_.store(array, std::memory_order_release);
+			}
+
+			array->store(bottom, data);
+			bottom_.store(bottom + 1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief pop a data from the bottom (owner thread only)
+		 * @param data a reference to receive data
+		 * @return pop success or not (false if the deque is empty or the last data was stolen)
+		*/
+		bool pop(reference data) noexcept
+		{
+			const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+			const auto* array = array_.load(std::memory_order_relaxed);
+			bottom_.store(bottom, std::memory_order_relaxed);
+			// pair with the fence in steal, either the thief sees our new bottom or we see its new top
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto top = top_.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// empty
+				bottom_.store(bottom + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			data = array->load(bottom);
+			if (top == bottom)
+			{
+				// the last one, race with the thieves
+				const auto won = top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				bottom_.store(bottom + 1, std::memory_order_relaxed);
+				return won;
+			}
+			return true;
+		}
+
+		/**
+		 * @brief steal a data from the top (any thread)
+		 * @param data a reference to receive data
+		 * @return steal success or not (false if the deque is empty or another thread won the race)
+		*/
+		bool steal(reference data) noexcept
+		{
+			auto top = top_.load(std::memory_order_acquire);
+			// pair with the fence in pop
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const auto bottom = bottom_.load(std::memory_order_acquire);
+
+			if (top >= bottom) { return false; }
+
+			const auto* array = array_.load(std::memory_order_acquire);
+			const auto value = array->load(top);
+			if (not top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) { return false; }
+
+			data = value;
+			return true;
+		}
+
+	private:
+		alignas(utils::cache_line_size) std::atomic<index_type> top_{0};
+		alignas(utils::cache_line_size) std::atomic<index_type> bottom_{0};
+		std::atomic<circular_array*> array_;
+		// all arrays ever used (owner thread only)
+		std::vector<std::unique_ptr<circular_array>> arrays_;
+	};
+}// namespace gal::toolbox::container
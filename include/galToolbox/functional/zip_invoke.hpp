@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <ranges>
 
 namespace gal::toolbox::functional
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+#include <galToolbox/utils/assert.hpp>
+#include <galToolbox/utils/cache_line.hpp>
+
+namespace gal::toolbox::string
+{
+	namespace concurrent_string_pool_detail
+	{
+		/**
+		 * @brief give every running thread a small dense index, the index of an exited thread is reused by the next new thread
+		 */
+		class thread_index_registry
+		{
+		public:
+			[[nodiscard]] std::size_t acquire()
+			{
+				std::scoped_lock lock{mutex_};
+				if (free_.empty()) { return next_++; }
+
+				const auto index = free_.back();
+				free_.pop_back();
+				return index;
+			}
+
+			void release(const std::size_t index)
+			{
+				std::scoped_lock lock{mutex_};
+				free_.push_back(index);
+			}
+
+			[[nodiscard]] static thread_index_registry& instance()
+			{
+				static thread_index_registry registry;
+				return registry;
+			}
+
+		private:
+			std::mutex mutex_;
+			std::vector<std::size_t> free_;
+			std::size_t next_ = 0;
+		};
+
+		/**
+		 * @brief get the index of the current thread (in [0, the max number of threads that ever ran at the same time))
+		 */
+		[[nodiscard]] inline std::size_t this_thread_index()
+		{
+			struct holder
+			{
+				std::size_t index = thread_index_registry::instance().acquire();
+
+				holder() = default;
+				holder(const holder&) = delete;
+				holder& operator=(const holder&) = delete;
+
+				~holder() { thread_index_registry::instance().release(index); }
+			};
+
+			thread_local const holder h;
+			return h.index;
+		}
+	}// namespace concurrent_string_pool_detail
+
+	/**
+	 * @brief a string pool that any number of threads can append to at the same time
+	 * @note every thread appends into its own current block without any lock (bump pointer),
+	 * only getting a new block takes the lock of the shared block registry,
+	 * a view is valid until the pool (or the pool that takes it over) is destroyed
+	 */
+	template<typename CharType = char, bool IsNullTerminate = true, typename CharTrait = std::char_traits<CharType>>
+	class concurrent_string_pool
+	{
+	public:
+		using view_type = std::basic_string_view<CharType, CharTrait>;
+		using value_type = typename view_type::value_type;
+		using size_type = typename view_type::size_type;
+
+		constexpr static size_type default_capacity = 8196;
+
+		// at most shards_per_page * max_shard_pages threads can append at the same time
+		constexpr static size_type shards_per_page = 64;
+		constexpr static size_type max_shard_pages = 64;
+
+	private:
+		struct block_type
+		{
+			std::unique_ptr<value_type[]> memory;
+			size_type capacity;
+			// only the thread whose current block it is changes it
+			size_type size;
+
+			explicit block_type(const size_type c)
+				: memory{std::make_unique_for_overwrite<value_type[]>(c)},
+				  capacity{c},
+				  size{0} {}
+
+			[[nodiscard]] size_type available_space() const noexcept { return capacity - size; }
+
+			[[nodiscard]] value_type* bump(const size_type length) noexcept
+			{
+				gal_assert(available_space() >= length, "There are not enough space for this string.");
+				const auto dest = memory.get() + size;
+				size += length;
+				return dest;
+			}
+		};
+
+		struct alignas(utils::cache_line_size) shard_type
+		{
+			block_type* current = nullptr;
+		};
+
+		using shard_page = std::array<shard_type, shards_per_page>;
+
+		std::atomic<size_type> capacity_;
+
+		// blocks and shard pages are only added or taken over under the lock
+		std::mutex mutex_;
+		std::vector<std::unique_ptr<block_type>> blocks_;
+		std::vector<std::unique_ptr<shard_page>> shard_pages_storage_;
+		std::array<std::atomic<shard_page*>, max_shard_pages> shard_pages_{};
+
+		[[nodiscard]] shard_type& this_thread_shard()
+		{
+			const auto index = concurrent_string_pool_detail::this_thread_index();
+			gal_assert(index < shards_per_page * max_shard_pages, "Too many threads.");
+
+			auto& page = shard_pages_[index / shards_per_page];
+			auto* p = page.load(std::memory_order_acquire);
+			if (p == nullptr)
+			{
+				std::scoped_lock lock{mutex_};
+				if (p = page.load(std::memory_order_relaxed); p == nullptr)
+				{
+					p = shard_pages_storage_.emplace_back(std::make_unique<shard_page>()).get();
+					page.store(p, std::memory_order_release);
+				}
+			}
+			return (*p)[index % shards_per_page];
+		}
+
+		[[nodiscard]] block_type* register_block(const size_type capacity)
+		{
+			// allocate outside the lock
+			auto block = std::make_unique<block_type>(capacity);
+
+			std::scoped_lock lock{mutex_};
+			return blocks_.emplace_back(std::move(block)).get();
+		}
+
+		/**
+		 * @brief get length chars from the current block of this thread (or a new block)
+		 */
+		[[nodiscard]] value_type* allocate(const size_type length)
+		{
+			auto& shard = this_thread_shard();
+			if (shard.current and shard.current->available_space() >= length) { return shard.current->bump(length); }
+
+			const auto capacity = capacity_.load(std::memory_order_relaxed);
+			// a string bigger than a block gets a block of its own, keep the current block for the next strings
+			if (length > capacity) { return this->register_block(length)->bump(length); }
+
+			shard.current = this->register_block(capacity);
+			return shard.current->bump(length);
+		}
+
+		/**
+		 * @brief forget the current blocks of all threads (they are taken over by another pool)
+		 */
+		void reset_shards() noexcept
+		{
+			for (auto& page: shard_pages_)
+			{
+				if (auto* p = page.load(std::memory_order_acquire)) { for (auto& shard: *p) { shard.current = nullptr; } }
+			}
+		}
+
+	public:
+		explicit concurrent_string_pool(const size_type capacity = default_capacity) noexcept
+			: capacity_{capacity} {}
+
+		concurrent_string_pool(const concurrent_string_pool&) = delete;
+		concurrent_string_pool& operator=(const concurrent_string_pool&) = delete;
+		concurrent_string_pool(concurrent_string_pool&&) = delete;
+		concurrent_string_pool& operator=(concurrent_string_pool&&) = delete;
+
+		~concurrent_string_pool() noexcept = default;
+
+		/**
+		 * @brief Add a string to the pool, and then you can freely use the added string (thread safe).
+		 */
+		view_type append(const view_type str)
+		{
+			const auto dest = this->allocate(str.size() + IsNullTerminate);
+			std::ranges::copy(str, dest);
+			if constexpr (IsNullTerminate) { dest[str.size()] = 0; }
+			return {dest, str.size()};
+		}
+
+		/**
+		 * @brief Borrow a block of memory to the pool, users can directly write strings in this memory area without worrying about its invalidation (thread safe).
+		 */
+		[[nodiscard]] value_type* borrow_raw(const size_type size)
+		{
+			const auto dest = this->allocate(size + IsNullTerminate);
+			if constexpr (IsNullTerminate) { dest[size] = 0; }
+			return dest;
+		}
+
+		/**
+		 * @brief Take over all blocks of other pools, their views stay valid as long as we live.
+		 * @note Thread safe for us, but no thread may append to the given pools at the same time.
+		 */
+		template<std::same_as<concurrent_string_pool>... Pools>
+		void takeover(Pools&&... pools)
+		{
+			std::scoped_lock lock{mutex_, pools.mutex_...};
+
+			blocks_.reserve(blocks_.size() + (pools.blocks_.size() + ...));
+			((blocks_.insert(blocks_.end(), std::make_move_iterator(pools.blocks_.begin()), std::make_move_iterator(pools.blocks_.end())),
+			  pools.blocks_.clear(),
+			  pools.reset_shards()),
+				...);
+		}
+
+		/**
+		 * @brief How many blocks we hold.
+		 */
+		[[nodiscard]] size_type size()
+		{
+			std::scoped_lock lock{mutex_};
+			return blocks_.size();
+		}
+
+		[[nodiscard]] size_type capacity() const noexcept { return capacity_.load(std::memory_order_relaxed); }
+
+		/**
+		 * @note Only affect the block created after modification
+		 */
+		void resize(const size_type capacity) noexcept { capacity_.store(capacity, std::memory_order_relaxed); }
+	};
+}// namespace gal::toolbox::string
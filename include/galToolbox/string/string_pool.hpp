@@ -1,14 +1,29 @@
 #pragma once
 
 #ifndef GAL_UTILS_STRING_POOL_DEBUG
-#ifndef _NDEBUG
+#ifndef NDEBUG
 #define GAL_UTILS_STRING_POOL_DEBUG
 #endif
 #endif
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <ostream>
 #include <ranges>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <galToolbox/utils/assert.hpp>
 #include <vector>
 
@@ -16,9 +31,145 @@
 #include <map>
 #endif
 
+#if __has_include(<sys/mman.h>) and __has_include(<fcntl.h>) and __has_include(<unistd.h>)
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+	#define GAL_STRING_POOL_MMAP_SUPPORTED
+#endif
+
 namespace gal::toolbox::string
 {
-	template<typename CharType = char, bool IsNullTerminate = true, typename CharTrait = std::char_traits<CharType>>
+	/**
+	 * @brief how string_pool chooses the block to put a new string in
+	 */
+	enum class string_pool_block_policy
+	{
+		// keep the blocks sorted by available space and take the best fit, lower_bound + rotate, O(n) per append
+		sorted,
+		// bucket the blocks by available space (2^n size classes) and take one from the smallest class that surely fits, O(1) per append
+		size_class,
+	};
+
+	namespace string_pool_detail
+	{
+		struct snapshot_symbol
+		{
+			// in chars, relative to the data section
+			std::uint64_t offset;
+			std::uint64_t length;
+		};
+
+		struct snapshot_slot
+		{
+			std::uint64_t hash;
+			std::uint32_t symbol;
+			std::uint32_t padding;
+		};
+
+		/**
+		 * @brief the layout of a snapshot file (see string_pool::save), all offsets are relative to the beginning of the file so it can be mapped anywhere
+		 * @note header | chars of all blocks | symbol table | intern slots, every section is 8 bytes aligned, the integers are native endian
+		 */
+		struct snapshot_header
+		{
+			constexpr static std::array<char, 8> magic_value{'g', 'a', 'l', 'S', 'P', 'o', 'o', 'l'};
+			// a byte swapped version never matches, so a file of the other endian is rejected
+			constexpr static std::uint32_t version_value = 1;
+			constexpr static std::size_t data_offset = 64;
+
+			std::array<char, 8> magic;
+			std::uint32_t version;
+			std::uint16_t char_size;
+			std::uint8_t null_terminate;
+			std::uint8_t hash_size;
+			// how many chars in the data section
+			std::uint64_t data_size;
+			std::uint64_t symbol_count;
+			std::uint64_t slot_count;
+
+			[[nodiscard]] constexpr static std::uint64_t align(const std::uint64_t offset) noexcept { return (offset + 7) / 8 * 8; }
+
+			[[nodiscard]] constexpr std::uint64_t symbols_offset() const noexcept { return align(data_offset + data_size * char_size); }
+
+			[[nodiscard]] constexpr std::uint64_t slots_offset() const noexcept { return symbols_offset() + symbol_count * sizeof(snapshot_symbol); }
+
+			[[nodiscard]] constexpr std::uint64_t file_size() const noexcept { return slots_offset() + slot_count * sizeof(snapshot_slot); }
+		};
+
+		static_assert(sizeof(snapshot_header) <= snapshot_header::data_offset);
+
+		/**
+		 * @brief the read only memory of a snapshot file, mapped if the platform supports it, otherwise read into the heap
+		 */
+		class snapshot_memory
+		{
+			const std::byte* data_{nullptr};
+			std::size_t size_{0};
+			std::unique_ptr<std::byte[]> heap_;
+
+			snapshot_memory() noexcept = default;
+
+		public:
+			snapshot_memory(const snapshot_memory&) = delete;
+			snapshot_memory& operator=(const snapshot_memory&) = delete;
+			snapshot_memory(snapshot_memory&&) = delete;
+			snapshot_memory& operator=(snapshot_memory&&) = delete;
+
+			~snapshot_memory() noexcept
+			{
+				#ifdef GAL_STRING_POOL_MMAP_SUPPORTED
+				if (not heap_ and data_ != nullptr) { munmap(const_cast<std::byte*>(data_), size_); }
+				#endif
+			}
+
+			[[nodiscard]] const std::byte* data() const noexcept { return data_; }
+
+			[[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+			/**
+			 * @brief open a file read only
+			 * @return memory, or nullptr if failed (or the file is empty)
+			 */
+			[[nodiscard]] static std::shared_ptr<const snapshot_memory> open(const std::filesystem::path& path)
+			{
+				std::shared_ptr<snapshot_memory> memory{new snapshot_memory{}};
+
+				#ifdef GAL_STRING_POOL_MMAP_SUPPORTED
+				if (const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC); fd != -1)
+				{
+					struct stat status{};
+					if (fstat(fd, &status) == 0 and status.st_size > 0)
+					{
+						const auto size = static_cast<std::size_t>(status.st_size);
+						// the pages are only read when a string in them is used
+						if (auto* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); data != MAP_FAILED)
+						{
+							memory->data_ = static_cast<const std::byte*>(data);
+							memory->size_ = size;
+						}
+					}
+					close(fd);
+					if (memory->data_ != nullptr) { return memory; }
+				}
+				#endif
+
+				std::ifstream file{path, std::ios::binary | std::ios::ate};
+				if (not file) { return nullptr; }
+				const auto size = static_cast<std::size_t>(file.tellg());
+				if (size == 0) { return nullptr; }
+
+				memory->heap_ = std::make_unique_for_overwrite<std::byte[]>(size);
+				if (not file.seekg(0).read(reinterpret_cast<char*>(memory->heap_.get()), static_cast<std::streamsize>(size))) { return nullptr; }
+				memory->data_ = memory->heap_.get();
+				memory->size_ = size;
+				return memory;
+			}
+		};
+	}// namespace string_pool_detail
+
+	template<typename CharType = char, bool IsNullTerminate = true, typename CharTrait = std::char_traits<CharType>, string_pool_block_policy BlockPolicy = string_pool_block_policy::sorted>
 	class string_pool
 	{
 		template<typename BlockCharType, bool BlockIsNullTerminate, typename BlockCharTrait>
@@ -72,48 +223,30 @@ namespace gal::toolbox::string
 
 			[[nodiscard]] constexpr value_type* borrow_raw(const size_type size) noexcept
 			{
-				if (not this->storable(size))
+				// the null terminator needs a char too
+				const auto length = size + is_null_terminate;
+				if (not this->storable(length))
 				{
-					gal_assert(this->storable(size), "There are not enough space for this string.");
+					gal_assert(this->storable(length), "There are not enough space for this string.");
 					return nullptr;
 				}
 
 				const auto dest = memory_.get() + size_;
 
 				if constexpr (is_null_terminate) { dest[size] = 0; }
-				size_ += size;
+				size_ += length;
 
 				return dest;
 			}
 
-			constexpr void return_raw(const value_type* raw, const size_type size) noexcept
-			{
-				auto memory_data = memory_.get();
-
-				gal_assert(memory_data >= (raw - (size_ - size)), "The given memory does not belong to this block");
-
-				if (memory_data > (raw - (size_ - size)))
-				{
-					// In this case, new string is inserted after the memory is borrowed, and the newly added string needs to be moved to the front
-					auto move_dest = memory_data + (raw - memory_data);// raw;
-					gal_assert(move_dest == raw);
-					auto move_source = raw + size;
-					auto move_size = size_ - size - (raw - memory_data);
-
-					std::ranges::copy_n(move_source, move_size, move_dest);
-				}
-
-				size_ -= size;
-
-				if constexpr (is_null_terminate) { memory_.get()[size_] = 0; }
-			}
-
 			[[nodiscard]] constexpr bool storable(const view_type str) const noexcept { return available_space() >= this->length_of(str); }
 
 			[[nodiscard]] constexpr bool storable(const size_type size) const noexcept { return available_space() >= size; }
 
 			[[nodiscard]] constexpr size_type available_space() const noexcept { return capacity_ - size_; }
 
+			[[nodiscard]] constexpr view_type used() const noexcept { return {memory_.get(), size_}; }
+
 			[[nodiscard]] constexpr bool more_available_space_than(const string_block& other) const noexcept { return available_space() > other.available_space(); }
 
 			friend constexpr void swap(string_block& lhs, string_block& rhs) noexcept
@@ -128,6 +261,101 @@ namespace gal::toolbox::string
 		using block_type = string_block<CharType, IsNullTerminate, CharTrait>;
 		using pool_type = std::vector<block_type>;
 
+		/**
+		 * @brief the index of string_pool_block_policy::size_class, the blocks never move, the buckets hold their indices
+		 */
+		class block_size_classes
+		{
+		public:
+			using size_type = typename block_type::size_type;
+
+			constexpr static size_type npos = static_cast<size_type>(-1);
+
+		private:
+			constexpr static std::uint8_t no_class = 0xff;
+
+			struct location
+			{
+				std::uint8_t size_class = no_class;
+				size_type position = 0;
+			};
+
+			// class n holds the blocks whose available space is in [2^n, 2^(n+1)), a full block is in no class
+			std::array<std::vector<size_type>, std::numeric_limits<size_type>::digits> classes_;
+			// block index -> where it is in classes_
+			std::vector<location> locations_;
+			// bit n is set if class n is not empty
+			std::uint64_t non_empty_ = 0;
+
+			[[nodiscard]] constexpr static std::uint8_t class_of(const size_type available) noexcept
+			{
+				if (available == 0) { return no_class; }
+				return static_cast<std::uint8_t>(std::bit_width(available) - 1);
+			}
+
+			constexpr void remove(const size_type index) noexcept
+			{
+				auto& [size_class, position] = locations_[index];
+				if (size_class == no_class) { return; }
+
+				// swap with the last one
+				auto& bucket = classes_[size_class];
+				bucket[position] = bucket.back();
+				locations_[bucket[position]].position = position;
+				bucket.pop_back();
+				if (bucket.empty()) { non_empty_ and_eq compl(std::uint64_t{1} << size_class); }
+
+				size_class = no_class;
+			}
+
+		public:
+			/**
+			 * @brief how many blocks are indexed
+			 */
+			[[nodiscard]] constexpr size_type size() const noexcept { return locations_.size(); }
+
+			/**
+			 * @brief the available space of the block at index is changed (or it is a new block)
+			 */
+			constexpr void update(const size_type index, const size_type available)
+			{
+				if (index >= locations_.size()) { locations_.resize(index + 1); }
+
+				const auto size_class = class_of(available);
+				if (locations_[index].size_class == size_class) { return; }
+
+				this->remove(index);
+				if (size_class == no_class) { return; }
+
+				auto& bucket = classes_[size_class];
+				bucket.push_back(index);
+				locations_[index] = {size_class, bucket.size() - 1};
+				non_empty_ or_eq std::uint64_t{1} << size_class;
+			}
+
+			/**
+			 * @brief find a block that can hold size chars
+			 * @param size chars needed
+			 * @param storable bool(size_type index), can the block at index hold size chars
+			 * @return index, or npos if there is no such block
+			 */
+			template<typename Storable>
+			[[nodiscard]] constexpr size_type find(const size_type size, Storable storable) const noexcept
+			{
+				if (size == 0) { return non_empty_ == 0 ? npos : classes_[std::countr_zero(non_empty_)].back(); }
+
+				// every block of class bit_width(size - 1) or higher can hold it
+				const auto sure = static_cast<std::size_t>(std::bit_width(size - 1));
+				// the blocks of the class below may be able to hold it, try one of them first (a better fit)
+				if (const auto maybe = sure - 1; sure not_eq 0 and ((non_empty_ >> maybe) bitand 1)) { if (const auto index = classes_[maybe].back(); storable(index)) { return index; } }
+
+				if (sure >= 64) { return npos; }
+				const auto candidates = non_empty_ bitand (compl std::uint64_t{0} << sure);
+				if (candidates == 0) { return npos; }
+				return classes_[std::countr_zero(candidates)].back();
+			}
+		};
+
 	public:
 		using view_type = typename block_type::view_type;
 		using value_type = typename block_type::value_type;
@@ -135,10 +363,41 @@ namespace gal::toolbox::string
 
 		constexpr static size_type default_capacity = 8196;
 
+		// the id of an interned string, two interned strings are equal if and only if their symbols are equal
+		using symbol_type = std::uint32_t;
+		constexpr static symbol_type invalid_symbol = std::numeric_limits<symbol_type>::max();
+
 	private:
+		struct intern_slot
+		{
+			size_type hash;
+			symbol_type symbol = invalid_symbol;
+		};
+
+		// the initial slot count of the intern table (2^n)
+		constexpr static size_type default_intern_capacity = 64;
+
+		/**
+		 * @brief the chars of an opened snapshot, they are never written and live as long as any pool that holds them
+		 */
+		struct mapped_region
+		{
+			std::shared_ptr<const string_pool_detail::snapshot_memory> memory;
+			view_type data;
+		};
+
 		pool_type pool_;
 		size_type capacity_;
 
+		[[no_unique_address]] std::conditional_t<BlockPolicy == string_pool_block_policy::size_class, block_size_classes, std::tuple<>> size_classes_;
+
+		// open addressing with linear probing, the slot count is 2^n and at most half of them are used
+		std::vector<intern_slot> intern_slots_;
+		// symbol -> interned string
+		std::vector<view_type> symbols_;
+
+		std::vector<mapped_region> mapped_;
+
 		using block_iterator = typename pool_type::iterator;
 
 		#ifdef GAL_UTILS_STRING_POOL_DEBUG
@@ -146,22 +405,48 @@ namespace gal::toolbox::string
 		#endif
 
 	public:
-		// todo: The borrower has many optimizations,
-		// such as separating the borrow pool from the actual pool,
-		// inserting strings into the borrower pool first,
-		// and then inserting it back into the actual pool when the borrower is destructed.
-		// The current implementation is to record where all strings are inserted, and then delete them one by one, which involves multiple moves (to move the following strings forward)
+		/**
+		 * @brief A scoped arena, the strings are put in its own blocks instead of the blocks of the pool.
+		 * @note When it is destroyed, all its blocks are released at once and the strings of the pool are never touched,
+		 * call break_promise to give its blocks to the pool instead (the strings then live as long as the pool).
+		 */
 		class block_borrower
 		{
 			std::reference_wrapper<string_pool> pool_;
-			// pair -> block memory view <=> which block
-			std::vector<std::pair<view_type, block_iterator>> borrowed_blocks_;
+			// the last block is the current one, the others are full (or hold a single long string)
+			pool_type blocks_;
 			bool need_return_ = true;
 
+			/**
+			 * @brief get a block that can hold size chars
+			 */
+			[[nodiscard]] constexpr block_type& block_for(const size_type size)
+			{
+				if (not blocks_.empty() and blocks_.back().storable(size)) { return blocks_.back(); }
+
+				const auto capacity = pool_.get().capacity();
+				// a string bigger than a block gets a block of its own, keep the current block for the next strings
+				if (size > capacity and not blocks_.empty()) { return *blocks_.emplace(std::ranges::prev(blocks_.end()), size); }
+				return blocks_.emplace_back(std::ranges::max(capacity, size));
+			}
+
+			constexpr void give_back() noexcept
+			{
+				if (need_return_) { blocks_.clear(); }
+				else { pool_.get().takeover_blocks(blocks_); }
+			}
+
 		public:
 			[[nodiscard]] constexpr bool need_return() const noexcept { return need_return_; }
 
-			constexpr void break_promise() noexcept { need_return_ = false; }
+			/**
+			 * @brief Give all blocks to the pool now, and all blocks created later when we are destroyed.
+			 */
+			constexpr void break_promise()
+			{
+				need_return_ = false;
+				pool_.get().takeover_blocks(blocks_);
+			}
 
 			constexpr explicit block_borrower(string_pool& pool) noexcept
 				: pool_{pool} {}
@@ -169,54 +454,33 @@ namespace gal::toolbox::string
 			constexpr block_borrower(const block_borrower&) = delete;
 			constexpr block_borrower& operator=(const block_borrower&) = delete;
 			constexpr block_borrower(block_borrower&&) noexcept = default;
-			constexpr block_borrower& operator=(block_borrower&&) = default;
 
-			constexpr ~block_borrower() noexcept
+			constexpr block_borrower& operator=(block_borrower&& other) noexcept
 			{
-				if (need_return_)
-				{
-					std::ranges::for_each(
-							// back to front, because the last inserted string is saved at the end
-							borrowed_blocks_ | std::views::reverse,
-							[this](auto& pair) mutable
-							{
-								auto& pool = pool_.get();
-
-								pool.return_raw_memory(pair.first, pair.second);
-								// todo: maybe a lock is needed here?
-								// erase is not performed because the target may still have memory in use.
-								// pool.erase(pair.second);
-							});
-				}
+				if (std::addressof(other) == this) { return *this; }
+				this->give_back();
+				pool_ = other.pool_;
+				blocks_ = std::exchange(other.blocks_, {});
+				need_return_ = other.need_return_;
+				return *this;
 			}
 
+			constexpr ~block_borrower() noexcept { this->give_back(); }
+
 			/**
-			 * @brief Add a string to the pool, and then you can freely use the added string.
+			 * @brief Add a string to the arena, it is valid until the arena is destroyed (or as long as the pool if the promise is broken).
 			 */
-			constexpr view_type append(const view_type str)
-			{
-				// see also: string_pool::append
-
-				// not only to insert the string, but also to save the inserted position
-				auto& pool = pool_.get();
-
-				auto pos = pool.find_or_create_block(str);
-				return borrowed_blocks_.emplace_back(pool.append_str_into_block(str, pos), pos).first;
-			}
+			constexpr view_type append(const view_type str) { return this->block_for(block_type::length_of(str)).append(str); }
 
 			/**
-			 * @brief Borrow a block of memory to the pool, users can directly write strings in this memory area without worrying about its invalidation.
+			 * @brief Borrow a block of memory to the arena, users can directly write strings in this memory area.
 			 */
-			[[nodiscard]] constexpr value_type* borrow_raw(const size_type size)
-			{
-				// see also: string_pool::borrow_raw
+			[[nodiscard]] constexpr value_type* borrow_raw(const size_type size) { return this->block_for(size + IsNullTerminate).borrow_raw(size); }
 
-				// not only to insert the string, but also to save the inserted position
-				auto& pool = pool_.get();
-
-				auto pos = pool.find_or_create_block(size);
-				return borrowed_blocks_.emplace_back({pool.borrow_raw_memory(size, pos), size}, pos).first.data();
-			}
+			/**
+			 * @brief How many blocks we hold.
+			 */
+			[[nodiscard]] constexpr size_type size() const noexcept { return blocks_.size(); }
 		};
 
 	private:
@@ -244,19 +508,6 @@ namespace gal::toolbox::string
 			return raw;
 		}
 
-		constexpr void return_raw_memory(const value_type* raw, const size_type size, block_iterator pos)
-		{
-			pos->return_raw(raw, size);
-
-			#ifdef GAL_UTILS_STRING_POOL_DEBUG
-			debug_mapping_.erase(view_type{raw, size});
-			#endif
-
-			this->shake_it(pos);
-		}
-
-		constexpr void return_raw_memory(view_type view, block_iterator pos) { this->return_raw_memory(view.data(), view.size(), pos); }
-
 		[[nodiscard]] constexpr block_iterator find_or_create_block(const size_type size)
 		{
 			if (const auto block = this->find_storable_block(size); block != pool_.end()) { return block; }
@@ -275,12 +526,23 @@ namespace gal::toolbox::string
 
 		[[nodiscard]] constexpr block_iterator find_storable_block(const size_type size) noexcept
 		{
-			return std::ranges::lower_bound(
-					this->find_first_possible_storable_block(size),
-					pool_.end(),
-					true,
-					[](bool b, bool) { return b; },
-					[size](const auto& block) { return not block.storable(size); });
+			// the null terminator needs a char too
+			const auto needed = size + IsNullTerminate;
+
+			if constexpr (BlockPolicy == string_pool_block_policy::size_class)
+			{
+				const auto index = size_classes_.find(needed, [this, needed](const auto i) { return pool_[i].storable(needed); });
+				return index == block_size_classes::npos ? pool_.end() : std::ranges::next(pool_.begin(), static_cast<std::ptrdiff_t>(index));
+			}
+			else
+			{
+				return std::ranges::lower_bound(
+						this->find_first_possible_storable_block(needed),
+						pool_.end(),
+						true,
+						[](bool b, bool) { return b; },
+						[needed](const auto& block) { return not block.storable(needed); });
+			}
 		}
 
 		[[nodiscard]] constexpr block_iterator find_storable_block(const view_type str) noexcept { return this->find_storable_block(str.size()); }
@@ -288,6 +550,7 @@ namespace gal::toolbox::string
 		[[nodiscard]] constexpr block_iterator create_storable_block(const size_type size)
 		{
 			pool_.emplace_back(std::ranges::max(capacity_, size + IsNullTerminate));
+			if constexpr (BlockPolicy == string_pool_block_policy::size_class) { size_classes_.update(pool_.size() - 1, pool_.back().available_space()); }
 			return std::ranges::prev(pool_.end());
 		}
 
@@ -295,6 +558,13 @@ namespace gal::toolbox::string
 
 		constexpr void shake_it(block_iterator block)
 		{
+			if constexpr (BlockPolicy == string_pool_block_policy::size_class)
+			{
+				// the blocks never move, just move it to its new class
+				size_classes_.update(static_cast<size_type>(std::ranges::distance(pool_.begin(), block)), block->available_space());
+				return;
+			}
+
 			if (
 				block == pool_.begin() ||
 				block->more_available_space_than(*std::ranges::prev(block))) { return; }
@@ -309,6 +579,94 @@ namespace gal::toolbox::string
 				it != block) { std::ranges::rotate(it, block, std::ranges::next(block)); }
 		}
 
+		/**
+		 * @brief FNV-1a, unlike std::hash it works for any CharTrait
+		 */
+		[[nodiscard]] constexpr static size_type hash_of(const view_type str) noexcept
+		{
+			std::uint64_t hash = 14695981039346656037ull;
+			for (const auto c: str) { hash = (hash xor static_cast<std::make_unsigned_t<value_type>>(c)) * 1099511628211ull; }
+			return static_cast<size_type>(hash);
+		}
+
+		/**
+		 * @brief find the slot of str, or the empty slot where it should be inserted
+		 */
+		[[nodiscard]] constexpr size_type find_intern_slot(const view_type str, const size_type hash) const noexcept
+		{
+			const auto mask = intern_slots_.size() - 1;
+			for (auto i = hash bitand mask;; i = (i + 1) bitand mask)
+			{
+				if (const auto& slot = intern_slots_[i];
+					slot.symbol == invalid_symbol or (slot.hash == hash and symbols_[slot.symbol] == str)) { return i; }
+			}
+		}
+
+		constexpr void grow_intern_slots()
+		{
+			std::vector<intern_slot> slots(std::ranges::max(intern_slots_.size() * 2, default_intern_capacity));
+
+			// the symbols are unique, just find an empty slot for each of them
+			const auto mask = slots.size() - 1;
+			for (const auto& slot: intern_slots_ | std::views::filter([](const auto& s) { return s.symbol not_eq invalid_symbol; }))
+			{
+				auto i = slot.hash bitand mask;
+				while (slots[i].symbol not_eq invalid_symbol) { i = (i + 1) bitand mask; }
+				slots[i] = slot;
+			}
+
+			intern_slots_ = std::move(slots);
+		}
+
+		/**
+		 * @brief get the symbol of str, add it if it has not been interned
+		 * @param str string
+		 * @param pooled str is already in our blocks (takeover), do not copy it again
+		 */
+		[[nodiscard]] constexpr symbol_type intern_str(const view_type str, const bool pooled)
+		{
+			if ((symbols_.size() + 1) * 2 > intern_slots_.size()) { this->grow_intern_slots(); }
+
+			const auto hash = hash_of(str);
+			auto& slot = intern_slots_[this->find_intern_slot(str, hash)];
+			if (slot.symbol == invalid_symbol)
+			{
+				gal_assert(symbols_.size() < invalid_symbol, "Too many interned strings.");
+
+				symbols_.push_back(pooled ? str : this->append(str));
+				slot = {hash, static_cast<symbol_type>(symbols_.size() - 1)};
+			}
+			return slot.symbol;
+		}
+
+		/**
+		 * @brief move all given blocks into our pool, the strings in them do not move
+		 */
+		constexpr void takeover_blocks(pool_type& blocks)
+		{
+			if constexpr (BlockPolicy == string_pool_block_policy::size_class)
+			{
+				// the blocks never move, just put the new ones in their classes
+				pool_.insert(pool_.end(), std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+				for (auto i = size_classes_.size(); i < pool_.size(); ++i) { size_classes_.update(i, pool_[i].available_space()); }
+			}
+			else
+			{
+				// the blocks of a pool are sorted already, the blocks of a borrower are not
+				std::ranges::sort(blocks, std::ranges::less{}, [](const auto& b) { return b.available_space(); });
+				const auto iterator = pool_.insert(pool_.end(), std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+				std::ranges::inplace_merge(pool_.begin(), iterator, pool_.end(), [](const auto& a, const auto& b) { return not a.more_available_space_than(b); });
+			}
+			blocks.clear();
+		}
+
+		constexpr void takeover_symbols(string_pool& other)
+		{
+			std::ranges::for_each(other.symbols_, [this](const auto str) { static_cast<void>(this->intern_str(str, true)); });
+			other.symbols_.clear();
+			other.intern_slots_.clear();
+		}
+
 	public:
 		constexpr explicit string_pool(size_type capacity = default_capacity) noexcept(std::is_nothrow_default_constructible_v<pool_type>)
 			: capacity_(capacity) {}
@@ -321,11 +679,11 @@ namespace gal::toolbox::string
 		{
 			pool_.reserve(pool_.size() + (pools.pool_.size() + ...));
 
-			block_iterator iterator;
-			(((iterator = pool_.insert(pool_.end(), std::make_move_iterator(pools.pool_.begin()), std::make_move_iterator(pools.pool_.end()))),
-			  pools.pool_.clear(),
-			  std::ranges::inplace_merge(pool_.begin(), iterator, pool_.end(), [](const auto& a, const auto& b) { return not a.more_available_space_than(b); })),
-				...);
+			((this->takeover_blocks(pools.pool_), pools.size_classes_ = {}), ...);
+			((mapped_.insert(mapped_.end(), std::make_move_iterator(pools.mapped_.begin()), std::make_move_iterator(pools.mapped_.end())), pools.mapped_.clear()), ...);
+
+			// their interned strings are ours now (they get new symbols)
+			(this->takeover_symbols(pools), ...);
 		}
 
 		template<std::same_as<string_pool>... Pools>
@@ -344,6 +702,195 @@ namespace gal::toolbox::string
 		 */
 		constexpr view_type append(const view_type str) { return this->append_str_into_block(str, this->find_or_create_block(str)); }
 
+		/**
+		 * @brief Add a string to the pool only if an equal string has not been interned, the same string always gets the same view.
+		 * @note Only the interned strings are deduplicated, a string added by append is never reused.
+		 */
+		constexpr view_type intern(const view_type str) { return symbols_[this->intern_symbol(str)]; }
+
+		/**
+		 * @brief The same as intern, but get the symbol of the string (compare two symbols instead of two strings).
+		 */
+		[[nodiscard]] constexpr symbol_type intern_symbol(const view_type str) { return this->intern_str(str, false); }
+
+		/**
+		 * @brief Get the symbol of an interned string without adding it.
+		 * @return symbol, or invalid_symbol if the string has not been interned
+		 */
+		[[nodiscard]] constexpr symbol_type find_symbol(const view_type str) const noexcept
+		{
+			if (symbols_.empty()) { return invalid_symbol; }
+			return intern_slots_[this->find_intern_slot(str, hash_of(str))].symbol;
+		}
+
+		/**
+		 * @brief Get the interned string of a symbol.
+		 */
+		[[nodiscard]] constexpr view_type symbol_view(const symbol_type symbol) const noexcept
+		{
+			gal_assert(symbol < symbols_.size(), "Invalid symbol.");
+			return symbols_[symbol];
+		}
+
+		/**
+		 * @brief How many different strings are interned.
+		 */
+		[[nodiscard]] constexpr size_type symbol_size() const noexcept { return symbols_.size(); }
+
+		/**
+		 * @brief Write all strings and the interned symbols into a snapshot, it can be opened later (see open).
+		 * @note The strings of an opened snapshot are written too, so a snapshot can be opened, extended and saved again
+		 * (into another file, the file we opened must not be modified while we hold it).
+		 */
+		void save(std::ostream& out) const
+		{
+			using string_pool_detail::snapshot_header;
+			using string_pool_detail::snapshot_slot;
+			using string_pool_detail::snapshot_symbol;
+
+			// every char we hold and where it goes in the data section
+			struct region
+			{
+				const value_type* begin;
+				size_type size;
+				std::uint64_t offset;
+			};
+
+			std::vector<region> regions;
+			std::uint64_t data_size = 0;
+			const auto add_region = [&regions, &data_size](const view_type chars)
+			{
+				if (chars.empty()) { return; }
+				regions.push_back({chars.data(), chars.size(), data_size});
+				data_size += chars.size();
+			};
+			std::ranges::for_each(mapped_, [&add_region](const auto& m) { add_region(m.data); });
+			std::ranges::for_each(pool_, [&add_region](const auto& block) { add_region(block.used()); });
+
+			const snapshot_header header{
+					.magic = snapshot_header::magic_value,
+					.version = snapshot_header::version_value,
+					.char_size = sizeof(value_type),
+					.null_terminate = IsNullTerminate,
+					.hash_size = sizeof(size_type),
+					.data_size = data_size,
+					.symbol_count = symbols_.size(),
+					.slot_count = intern_slots_.size()};
+
+			std::uint64_t written = 0;
+			const auto write = [&out, &written](const void* data, const std::uint64_t size)
+			{
+				out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+				written += size;
+			};
+			const auto pad_to = [&write, &written](const std::uint64_t offset)
+			{
+				constexpr std::array<char, snapshot_header::data_offset> zeros{};
+				write(zeros.data(), offset - written);
+			};
+
+			write(&header, sizeof(header));
+			pad_to(snapshot_header::data_offset);
+			std::ranges::for_each(regions, [&write](const auto& r) { write(r.begin, r.size * sizeof(value_type)); });
+			pad_to(header.symbols_offset());
+
+			// the symbols are views of our chars, find the region of each of them
+			std::ranges::sort(regions, std::less{}, &region::begin);
+			std::ranges::for_each(
+					symbols_,
+					[&write, &regions](const view_type str)
+					{
+						const auto it = std::ranges::prev(std::ranges::upper_bound(regions, str.data(), std::less{}, &region::begin));
+						gal_assert(str.data() >= it->begin and str.data() + str.size() <= it->begin + it->size, "The interned string does not belong to this pool.");
+
+						const snapshot_symbol symbol{.offset = it->offset + static_cast<std::uint64_t>(str.data() - it->begin), .length = str.size()};
+						write(&symbol, sizeof(symbol));
+					});
+			std::ranges::for_each(
+					intern_slots_,
+					[&write](const auto& slot)
+					{
+						const snapshot_slot s{.hash = slot.hash, .symbol = slot.symbol, .padding = 0};
+						write(&s, sizeof(s));
+					});
+		}
+
+		/**
+		 * @brief Open a snapshot written by save, the strings are not copied, the views point straight into the (mapped) file.
+		 * @param path snapshot file
+		 * @param capacity capacity of the blocks created for the strings added later
+		 * @return pool, or std::nullopt if the file cannot be read or is not a snapshot of this kind of pool
+		 * @note The file is mapped read only if the platform supports it (otherwise it is read into memory),
+		 * it must not be modified while any pool holds it. The interned symbols stay the same.
+		 */
+		[[nodiscard]] static std::optional<string_pool> open(const std::filesystem::path& path, const size_type capacity = default_capacity)
+		{
+			using string_pool_detail::snapshot_header;
+			using string_pool_detail::snapshot_slot;
+			using string_pool_detail::snapshot_symbol;
+
+			const auto memory = string_pool_detail::snapshot_memory::open(path);
+			if (not memory or memory->size() < snapshot_header::data_offset) { return std::nullopt; }
+
+			snapshot_header header;
+			std::memcpy(&header, memory->data(), sizeof(header));
+			if (
+				header.magic not_eq snapshot_header::magic_value or
+				header.version not_eq snapshot_header::version_value or
+				header.char_size not_eq sizeof(value_type) or
+				header.null_terminate not_eq IsNullTerminate or
+				header.hash_size not_eq sizeof(size_type)) { return std::nullopt; }
+
+			// the counts come from the file, make sure the offsets computed from them do not overflow
+			const auto file_size = memory->size();
+			if (
+				header.data_size > file_size / sizeof(value_type) or
+				header.symbol_count > file_size / sizeof(snapshot_symbol) or
+				header.slot_count > file_size / sizeof(snapshot_slot) or
+				header.file_size() not_eq file_size) { return std::nullopt; }
+			// the probing of find_intern_slot only stops if there is an empty slot
+			if (
+				(header.slot_count not_eq 0 and not std::has_single_bit(header.slot_count)) or
+				(header.symbol_count not_eq 0 and header.symbol_count * 2 > header.slot_count)) { return std::nullopt; }
+
+			string_pool pool{capacity};
+			const auto* data = reinterpret_cast<const value_type*>(memory->data() + snapshot_header::data_offset);
+
+			pool.symbols_.reserve(header.symbol_count);
+			for (std::uint64_t i = 0; i < header.symbol_count; ++i)
+			{
+				snapshot_symbol symbol;
+				std::memcpy(&symbol, memory->data() + header.symbols_offset() + i * sizeof(symbol), sizeof(symbol));
+
+				if (symbol.offset > header.data_size) { return std::nullopt; }
+				// the null terminator must be in the data section too
+				if (const auto rest = header.data_size - symbol.offset; symbol.length > rest or (IsNullTerminate and symbol.length == rest)) { return std::nullopt; }
+				pool.symbols_.emplace_back(data + symbol.offset, symbol.length);
+			}
+
+			// every symbol has exactly one slot, so the non-empty slots are exactly symbol_count and the bound above leaves an empty one
+			std::vector<bool> seen(header.symbol_count);
+			std::uint64_t occupied = 0;
+			pool.intern_slots_.resize(header.slot_count);
+			for (std::uint64_t i = 0; i < header.slot_count; ++i)
+			{
+				snapshot_slot slot;
+				std::memcpy(&slot, memory->data() + header.slots_offset() + i * sizeof(slot), sizeof(slot));
+
+				if (slot.symbol not_eq invalid_symbol)
+				{
+					if (slot.symbol >= header.symbol_count or seen[slot.symbol]) { return std::nullopt; }
+					seen[slot.symbol] = true;
+					++occupied;
+				}
+				pool.intern_slots_[i] = {static_cast<size_type>(slot.hash), slot.symbol};
+			}
+			if (occupied not_eq header.symbol_count) { return std::nullopt; }
+
+			pool.mapped_.push_back({memory, view_type{data, header.data_size}});
+			return pool;
+		}
+
 		/**
 		 * @brief Borrow a block of memory to the pool, users can directly write strings in this memory area without worrying about its invalidation.
 		 */
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace gal::toolbox::utils
+{
+	/**
+	 * @brief the minimum offset between two objects to avoid false sharing
+	 * @note gcc warns about using std::hardware_destructive_interference_size in headers (its value depends on -mtune),
+	 * so we only trust it on msvc and fall back to the common 64 bytes everywhere else
+	*/
+	#if defined(_MSC_VER) and defined(__cpp_lib_hardware_interference_size)
+	constexpr std::size_t cache_line_size = std::hardware_destructive_interference_size;
+	#else
+	constexpr std::size_t cache_line_size = 64;
+	#endif
+}// namespace gal::toolbox::utils
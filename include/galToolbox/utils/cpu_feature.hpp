@@ -0,0 +1,105 @@
+#pragma once
+
+#if defined(_M_X64) or defined(_M_IX86) or defined(__x86_64__) or defined(__i386__)
+	#define GAL_CPU_X86
+
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+/**
+ * @brief compile a function for the given instruction set (e.g. GAL_TARGET("avx2")) so that it can use the intrinsics
+ * without building the whole program for that instruction set, only call it after checking this_cpu_feature()
+ * @note msvc does not need (and does not have) it, the intrinsics are always available
+*/
+#ifdef _MSC_VER
+	#define GAL_TARGET(...)
+#else
+	#define GAL_TARGET(...) __attribute__((target(__VA_ARGS__)))
+#endif
+
+namespace gal::toolbox::utils
+{
+	/**
+	 * @brief the instruction sets we have a special kernel for (only the ones the cpu *and* the os support are true)
+	*/
+	struct cpu_feature
+	{
+		bool sse2;
+		bool popcnt;
+		bool avx2;
+		bool avx512f;
+		bool avx512_vpopcntdq;
+	};
+
+	namespace cpu_feature_detail
+	{
+		#ifdef GAL_CPU_X86
+		inline void cpuid(const unsigned leaf, const unsigned sub_leaf, unsigned (&registers)[4]) noexcept
+		{
+			#ifdef _MSC_VER
+			int r[4];
+			__cpuidex(r, static_cast<int>(leaf), static_cast<int>(sub_leaf));
+			for (int i = 0; i < 4; ++i) { registers[i] = static_cast<unsigned>(r[i]); }
+			#else
+			__cpuid_count(leaf, sub_leaf, registers[0], registers[1], registers[2], registers[3]);
+			#endif
+		}
+
+		inline unsigned long long xgetbv() noexcept
+		{
+			#ifdef _MSC_VER
+			return _xgetbv(0);
+			#else
+			unsigned eax, edx;
+			asm volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+			return (static_cast<unsigned long long>(edx) << 32) bitor eax;
+			#endif
+		}
+
+		inline cpu_feature detect() noexcept
+		{
+			cpu_feature feature{};
+
+			unsigned registers[4]{};
+			cpuid(0, 0, registers);
+			const auto max_leaf = registers[0];
+
+			cpuid(1, 0, registers);
+			feature.sse2 = (registers[3] bitand (1u << 26)) not_eq 0;
+			feature.popcnt = (registers[2] bitand (1u << 23)) not_eq 0;
+
+			// the os must save the ymm/zmm registers on context switch
+			const bool os_xsave = (registers[2] bitand (1u << 27)) not_eq 0;
+			const auto xcr0 = os_xsave ? xgetbv() : 0;
+			const bool os_avx = (xcr0 bitand 0x06) == 0x06;
+			const bool os_avx512 = (xcr0 bitand 0xe6) == 0xe6;
+
+			if (max_leaf >= 7)
+			{
+				cpuid(7, 0, registers);
+				feature.avx2 = os_avx and (registers[1] bitand (1u << 5)) not_eq 0;
+				feature.avx512f = os_avx512 and (registers[1] bitand (1u << 16)) not_eq 0;
+				feature.avx512_vpopcntdq = feature.avx512f and (registers[2] bitand (1u << 14)) not_eq 0;
+			}
+
+			return feature;
+		}
+		#else
+		inline cpu_feature detect() noexcept { return {}; }
+		#endif
+	}// namespace cpu_feature_detail
+
+	/**
+	 * @brief get the features of the cpu we are running on (detected once)
+	 * @return features
+	*/
+	[[nodiscard]] inline const cpu_feature& this_cpu_feature() noexcept
+	{
+		static const cpu_feature feature = cpu_feature_detail::detect();
+		return feature;
+	}
+}// namespace gal::toolbox::utils
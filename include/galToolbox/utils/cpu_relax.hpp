@@ -0,0 +1,23 @@
+#pragma once
+
+#if defined(_MSC_VER) and (defined(_M_X64) or defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace gal::toolbox::utils
+{
+	/**
+	 * @brief tell the cpu we are in a spin-wait loop (the pause/yield instruction),
+	 * this saves power and gives the sibling hyper-thread more resources
+	*/
+	inline void cpu_relax() noexcept
+	{
+		#if defined(_MSC_VER) and (defined(_M_X64) or defined(_M_IX86))
+		_mm_pause();
+		#elif defined(__x86_64__) or defined(__i386__)
+		__builtin_ia32_pause();
+		#elif defined(__aarch64__) or defined(__arm__)
+		asm volatile("yield");
+		#endif
+	}
+}// namespace gal::toolbox::utils
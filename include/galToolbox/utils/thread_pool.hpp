@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <galToolbox/container/work_stealing_deque.hpp>
+#include <galToolbox/utils/cache_line.hpp>
+
+namespace gal::toolbox::utils
+{
+	/**
+	 * @brief a small thread pool with one work-stealing deque per worker
+	 * @note a task submitted by a worker goes to the bottom of its own deque (no contention),
+	 * a task submitted by any other thread goes to a shared injection queue,
+	 * an idle worker first drains its own deque, then the injection queue, then steals from the other workers
+	*/
+	class thread_pool
+	{
+	public:
+		using size_type = std::size_t;
+		using task_type = std::function<void()>;
+
+	private:
+		using deque_type = container::work_stealing_deque<task_type*>;
+
+		struct alignas(cache_line_size) worker
+		{
+			deque_type deque;
+			std::thread thread;
+		};
+
+		struct this_thread_info
+		{
+			const thread_pool* pool;
+			size_type index;
+		};
+
+		inline static thread_local this_thread_info this_thread_{nullptr, 0};
+
+	public:
+		/**
+		 * @brief construct a thread pool and start the workers
+		 * @param workers how many workers (at least 1)
+		*/
+		explicit thread_pool(const size_type workers = std::max(1u, std::thread::hardware_concurrency()))
+			: workers_(std::max<size_type>(1, workers))
+		{
+			for (size_type i = 0; i < workers_.size(); ++i) { workers_[i].thread = std::thread{[this, i] { run(i); }}; }
+		}
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+		thread_pool(thread_pool&&) = delete;
+		thread_pool& operator=(thread_pool&&) = delete;
+
+		/**
+		 * @brief finish all submitted tasks (including the tasks they submit) and then stop the workers
+		*/
+		~thread_pool() noexcept
+		{
+			stopping_.store(true);
+			wake_.fetch_add(1);
+			wake_.notify_all();
+
+			for (auto& w: workers_) { w.thread.join(); }
+		}
+
+		[[nodiscard]] size_type size() const noexcept { return workers_.size(); }
+
+		/**
+		 * @brief submit a task
+		 * @tparam Function function type
+		 * @param function a callable without parameters, the result (if any) is discarded
+		 * @note if the task throws, the first exception is kept and rethrown by wait
+		*/
+		template<typename Function>
+			requires std::is_invocable_v<Function>
+		void submit(Function&& function)
+		{
+			auto task = std::make_unique<task_type>(std::forward<Function>(function));
+
+			unfinished_.fetch_add(1);
+			try
+			{
+				if (this_thread_.pool == this) { workers_[this_thread_.index].deque.push(task.get()); }
+				else
+				{
+					std::scoped_lock lock(injection_mutex_);
+					injection_.push_back(task.get());
+				}
+			}
+			catch (...)
+			{
+				finish_one();
+				throw;
+			}
+			static_cast<void>(task.release());
+
+			// pair with park, either the worker sees the new task or we see it sleeping
+			pending_.fetch_add(1);
+			if (sleepers_.load() != 0)
+			{
+				wake_.fetch_add(1);
+				wake_.notify_one();
+			}
+		}
+
+		/**
+		 * @brief block until all submitted tasks (including the tasks they submit) are finished
+		 * @note do not call it from a task, the worker would wait for itself
+		 * @throw the first exception thrown by a task since the last wait (the other tasks still run to the end)
+		*/
+		void wait()
+		{
+			for (auto unfinished = unfinished_.load(); unfinished != 0; unfinished = unfinished_.load()) { unfinished_.wait(unfinished); }
+
+			std::exception_ptr exception;
+			{
+				std::scoped_lock lock(exception_mutex_);
+				exception = std::exchange(exception_, nullptr);
+			}
+			if (exception) { std::rethrow_exception(exception); }
+		}
+
+	private:
+		void finish_one() noexcept
+		{
+			if (unfinished_.fetch_sub(1) == 1) { unfinished_.notify_all(); }
+		}
+
+		void execute(task_type& task) noexcept
+		{
+			try { task(); }
+			catch (...)
+			{
+				std::scoped_lock lock(exception_mutex_);
+				if (not exception_) { exception_ = std::current_exception(); }
+			}
+		}
+
+		void run(const size_type index)
+		{
+			this_thread_ = {this, index};
+
+			for (;;)
+			{
+				if (auto* task = take(index))
+				{
+					pending_.fetch_sub(1);
+					execute(*task);
+					delete task;
+
+					finish_one();
+					continue;
+				}
+
+				// someone is pushing a task right now, or a thief is holding the last one
+				if (pending_.load() != 0)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+
+				if (stopping_.load()) { return; }
+
+				park();
+			}
+		}
+
+		[[nodiscard]] task_type* take(const size_type index)
+		{
+			task_type* task = nullptr;
+
+			if (workers_[index].deque.pop(task)) { return task; }
+
+			{
+				std::scoped_lock lock(injection_mutex_);
+				if (not injection_.empty())
+				{
+					task = injection_.front();
+					injection_.pop_front();
+					return task;
+				}
+			}
+
+			for (size_type i = 1; i < workers_.size(); ++i)
+			{
+				if (workers_[(index + i) % workers_.size()].deque.steal(task)) { return task; }
+			}
+
+			return nullptr;
+		}
+
+		void park()
+		{
+			sleepers_.fetch_add(1);
+			// pair with submit, either we see the new task or the submitter sees us sleeping
+			if (const auto wake = wake_.load(); pending_.load() == 0 and not stopping_.load()) { wake_.wait(wake); }
+			sleepers_.fetch_sub(1);
+		}
+
+		std::vector<worker> workers_;
+
+		std::mutex injection_mutex_;
+		std::deque<task_type*> injection_;
+
+		// submitted but not taken
+		alignas(cache_line_size) std::atomic<size_type> pending_{0};
+		// submitted but not finished
+		alignas(cache_line_size) std::atomic<size_type> unfinished_{0};
+
+		alignas(cache_line_size) std::atomic<size_type> sleepers_{0};
+		std::atomic<std::uint32_t> wake_{0};
+		std::atomic<bool> stopping_{false};
+
+		// the first exception thrown by a task, rethrown by wait
+		std::mutex exception_mutex_;
+		std::exception_ptr exception_;
+	};
+}// namespace gal::toolbox::utils
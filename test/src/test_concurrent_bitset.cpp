@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/container/concurrent_bitset.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace gal::toolbox::container;
+
+TEST(TestConcurrentBitset, TestSetAndTest)
+{
+	concurrent_bitset<100> fixed;
+	using size_type = concurrent_bitset<100>::size_type;
+
+	ASSERT_EQ(fixed.size(), static_cast<size_type>(100));
+	ASSERT_EQ(fixed.block_size(), static_cast<size_type>(2));
+	ASSERT_TRUE(fixed.none());
+
+	ASSERT_FALSE(fixed.test_and_set(3));
+	ASSERT_TRUE(fixed.test_and_set(3));
+	ASSERT_TRUE(fixed.test_and_set(3, std::memory_order_relaxed));
+	ASSERT_FALSE(fixed.test_and_set(99, std::memory_order_relaxed));
+	ASSERT_TRUE(fixed.test(3));
+	ASSERT_TRUE(fixed.test(99, std::memory_order_relaxed));
+	ASSERT_FALSE(fixed.test(4));
+
+	ASSERT_TRUE(fixed.test_and_reset(3));
+	ASSERT_FALSE(fixed.test_and_reset(3));
+	ASSERT_FALSE(fixed.test_and_flip(64));
+	ASSERT_TRUE(fixed.test(64));
+	fixed.flip(64);
+	fixed.set(0);
+	fixed.reset(99);
+	ASSERT_EQ(fixed.count(), static_cast<size_type>(1));
+
+	// set a whole block at once, the bits this call set are the ones that were 0 before
+	const auto before = fixed.fetch_or_block(0, 0b1111);
+	ASSERT_EQ(before, 0b0001u);
+	ASSERT_EQ(0b1111 bitand compl before, 0b1110u);
+	ASSERT_EQ(fixed.load_block(0), 0b1111u);
+	ASSERT_EQ(fixed.fetch_and_block(0, 0b0101), 0b1111u);
+	ASSERT_EQ(fixed.count(), static_cast<size_type>(2));
+
+	const auto snapshot = fixed.to_dynamic_bitset();
+	ASSERT_EQ(snapshot.size(), static_cast<size_type>(100));
+	ASSERT_EQ(snapshot.count(), static_cast<size_type>(2));
+	ASSERT_TRUE(snapshot.test(0));
+	ASSERT_TRUE(snapshot.test(2));
+
+	fixed.clear();
+	ASSERT_TRUE(fixed.none());
+}
+
+TEST(TestConcurrentBitset, TestResize)
+{
+	concurrent_bitset<> bitset{130};
+	using size_type = concurrent_bitset<>::size_type;
+
+	bitset.set(5);
+	bitset.set(70);
+	bitset.set(129);
+	ASSERT_EQ(bitset.count(), static_cast<size_type>(3));
+
+	bitset.resize(1000);
+	ASSERT_EQ(bitset.size(), static_cast<size_type>(1000));
+	ASSERT_EQ(bitset.count(), static_cast<size_type>(3));
+	ASSERT_TRUE(bitset.test(129));
+	ASSERT_FALSE(bitset.test(999));
+
+	// the bits past the new size are dropped
+	bitset.resize(70);
+	ASSERT_EQ(bitset.count(), static_cast<size_type>(1));
+	bitset.resize(200);
+	ASSERT_FALSE(bitset.test(70));
+	ASSERT_FALSE(bitset.test(129));
+
+	// growing from a block-aligned size keeps the high bits of the old last block
+	concurrent_bitset<> aligned{128};
+	aligned.set(63);
+	aligned.set(127);
+	aligned.resize(1000);
+	ASSERT_TRUE(aligned.test(63));
+	ASSERT_TRUE(aligned.test(127));
+	ASSERT_EQ(aligned.count(), static_cast<size_type>(2));
+}
+
+TEST(TestConcurrentBitset, TestMultiThread)
+{
+	// every thread tries to mark every vertex, each vertex must be claimed by exactly one thread
+	constexpr std::size_t vertices = 1 << 16;
+	constexpr std::size_t thread_count = 8;
+
+	concurrent_bitset<> visited{vertices};
+	std::atomic<std::size_t> claimed{0};
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < thread_count; ++t)
+	{
+		threads.emplace_back(
+				[&, t]
+				{
+					std::size_t mine = 0;
+					for (std::size_t i = 0; i < vertices; ++i)
+					{
+						// walk in different orders so that the threads really race
+						const auto vertex = (i * (2 * t + 1)) % vertices;
+						if (not visited.test_and_set(vertex, t % 2 == 0 ? std::memory_order_relaxed : std::memory_order_acq_rel)) { ++mine; }
+					}
+					claimed += mine;
+				});
+	}
+	for (auto& thread: threads) { thread.join(); }
+
+	ASSERT_EQ(claimed.load(), vertices);
+	ASSERT_EQ(visited.count(), vertices);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/string/concurrent_string_pool.hpp>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gal::toolbox::string;
+
+namespace
+{
+	std::string make_string(const std::size_t thread, const std::size_t i) { return std::to_string(thread) + "-" + std::to_string(i) + std::string(i % 17, 'x'); }
+}// namespace
+
+TEST(TestConcurrentStringPool, TestConcurrentAppend)
+{
+	constexpr std::size_t threads = 8;
+	constexpr std::size_t strings_per_thread = 5000;
+
+	concurrent_string_pool<char> pool{256};
+
+	std::vector<std::vector<std::string_view>> views(threads);
+	{
+		std::vector<std::jthread> workers;
+		for (std::size_t t = 0; t < threads; ++t)
+		{
+			workers.emplace_back(
+					[&, t]
+					{
+						for (std::size_t i = 0; i < strings_per_thread; ++i) { views[t].push_back(pool.append(make_string(t, i))); }
+					});
+		}
+	}
+
+	// the views stay valid after the threads exit
+	for (std::size_t t = 0; t < threads; ++t)
+	{
+		ASSERT_EQ(views[t].size(), strings_per_thread);
+		for (std::size_t i = 0; i < strings_per_thread; ++i)
+		{
+			ASSERT_EQ(views[t][i], make_string(t, i));
+			ASSERT_EQ(views[t][i].data()[views[t][i].size()], '\0');
+		}
+	}
+}
+
+TEST(TestConcurrentStringPool, TestLongString)
+{
+	concurrent_string_pool<char, false> pool{16};
+
+	const auto s1 = pool.append("short");
+	const std::string long_string(100, 'l');
+	const auto s2 = pool.append(long_string);
+	// the current block is kept for the next short strings
+	const auto s3 = pool.append("after");
+
+	ASSERT_EQ(s1, "short");
+	ASSERT_EQ(s2, long_string);
+	ASSERT_EQ(s3, "after");
+	ASSERT_EQ(s1.data() + s1.size(), s3.data());
+	ASSERT_EQ(pool.size(), 2);
+
+	pool.resize(1024);
+	ASSERT_EQ(pool.capacity(), 1024);
+	const auto raw = pool.borrow_raw(200);
+	std::memcpy(raw, long_string.data(), 100);
+	ASSERT_EQ(std::string_view(raw, 100), long_string);
+	ASSERT_EQ(pool.size(), 3);
+}
+
+TEST(TestConcurrentStringPool, TestTakeover)
+{
+	concurrent_string_pool<wchar_t> pool;
+
+	std::vector<std::wstring_view> views;
+	{
+		concurrent_string_pool<wchar_t> p1;
+		concurrent_string_pool<wchar_t> p2;
+
+		std::jthread t1{[&] { views.push_back(p1.append(L"from p1")); }};
+		t1.join();
+		std::jthread t2{[&] { views.push_back(p2.append(L"from p2")); }};
+		t2.join();
+		views.push_back(pool.append(L"from pool"));
+
+		pool.takeover(std::move(p1), std::move(p2));
+		ASSERT_EQ(pool.size(), 3);
+		ASSERT_EQ(p1.size(), 0);
+		ASSERT_EQ(p2.size(), 0);
+
+		// the taken pools can still be used, with new blocks of their own
+		ASSERT_EQ(p1.append(L"p1 again"), L"p1 again");
+		ASSERT_EQ(p1.size(), 1);
+	}
+
+	ASSERT_EQ(views[0], L"from p1");
+	ASSERT_EQ(views[1], L"from p2");
+	ASSERT_EQ(views[2], L"from pool");
+	ASSERT_STREQ(views[0].data(), L"from p1");
+}
@@ -2,10 +2,10 @@
 
 #include <bitset>
 #include <galToolbox/container/dynamic_bitset.hpp>
-#include <galToolbox/utils/assert.hpp>
+#include <cctype>
+#include <cmath>
 #include <fstream>
-
-#ifndef GALTOOLBOX_DYNAMIC_BITSET_NOT_SUPPORTED
+#include <sstream>
 
 using namespace gal::toolbox::container;
 
@@ -17,7 +17,7 @@ TEST(TestDynamicBitset, TestConstructAndOutput)
 	// fake std::cin input
 	{
 		std::ofstream file(filename, std::ios::out | std::ios::ate);
-		gal::gal_assert(file.is_open());
+		ASSERT_TRUE(file.is_open());
 		file << "11111111110000000000000001111111111100000000000" << std::endl;
 		file.close();
 	}
@@ -139,4 +139,557 @@ TEST(TestDynamicBitset, TestConstructAndOutput)
 	std::cout << "cast to unsigned long: " << bits1.cast_to<unsigned long>() << "\ncast to string: " << bits1.to_string() << "\n\n";
 }
 
-#endif
+TEST(TestDynamicBitset, TestCount)
+{
+	using size_type = basic_dynamic_bitset::size_type;
+
+	// cover the scalar path, the Harley-Seal main loop (16 vectors) and all kinds of tails
+	for (const size_type bits: {size_type{0}, size_type{1}, size_type{63}, size_type{64}, size_type{1000}, size_type{4096}, size_type{4096 + 7 * 64 + 13}, size_type{100000}})
+	{
+		basic_dynamic_bitset bitset(bits);
+
+		size_type expected = 0;
+		for (size_type i = 0; i < bits; ++i)
+		{
+			if (i % 3 == 0 or i % 7 == 0)
+			{
+				bitset.set(i);
+				++expected;
+			}
+		}
+
+		ASSERT_EQ(bitset.count(), expected) << bits;
+	}
+
+	// every kernel the cpu supports
+	std::vector<std::uint64_t> blocks(3 * 1024 + 5);
+	for (std::size_t i = 0; i < blocks.size(); ++i) { blocks[i] = 0x9e3779b97f4a7c15ull * (i + 1); }
+
+	for (const std::size_t size: {std::size_t{0}, std::size_t{7}, std::size_t{64}, blocks.size()})
+	{
+		const auto expected = details::popcount_scalar(blocks.data(), size);
+
+		ASSERT_EQ(details::popcount(blocks.data(), size), expected);
+		#ifdef GAL_CPU_X86
+		const auto& feature = gal::toolbox::utils::this_cpu_feature();
+		if (feature.popcnt) { ASSERT_EQ(details::popcount_popcnt(blocks.data(), size), expected); }
+		if (feature.avx2) { ASSERT_EQ(details::popcount_avx2(blocks.data(), size), expected); }
+		if (feature.avx512_vpopcntdq) { ASSERT_EQ(details::popcount_avx512(blocks.data(), size), expected); }
+		#endif
+	}
+
+	#if defined(GAL_NO_ASSERT) and defined(GALTOOLBOX_DYNAMIC_BITSET_CONSTEXPR_SUPPORTED)
+	// the lookup table path is still used during constant evaluation
+	static_assert(basic_dynamic_bitset{10, 1023}.count() == 12);
+	#endif
+}
+
+TEST(TestDynamicBitset, TestBulkOperation)
+{
+	using size_type = basic_dynamic_bitset::size_type;
+
+	// below and above the vector threshold, with a tail that does not fill a vector
+	for (const size_type bits: {size_type{100}, size_type{64 * 64 + 3 * 64 + 17}})
+	{
+		basic_dynamic_bitset a(bits);
+		basic_dynamic_bitset b(bits);
+		for (size_type i = 0; i < bits; ++i)
+		{
+			if (i % 3 == 0) { a.set(i); }
+			if (i % 5 == 0) { b.set(i); }
+		}
+
+		auto a_and_b = a;
+		a_and_b &= b;
+		auto a_or_b = a;
+		a_or_b |= b;
+		auto a_xor_b = a;
+		a_xor_b ^= b;
+		auto a_sub_b = a;
+		a_sub_b -= b;
+
+		for (size_type i = 0; i < bits; ++i)
+		{
+			ASSERT_EQ(a_and_b.test(i), a.test(i) and b.test(i)) << bits << ' ' << i;
+			ASSERT_EQ(a_or_b.test(i), a.test(i) or b.test(i)) << bits << ' ' << i;
+			ASSERT_EQ(a_xor_b.test(i), a.test(i) not_eq b.test(i)) << bits << ' ' << i;
+			ASSERT_EQ(a_sub_b.test(i), a.test(i) and not b.test(i)) << bits << ' ' << i;
+		}
+
+		ASSERT_TRUE(a_and_b.is_subset_of(a));
+		ASSERT_TRUE(a_and_b.is_proper_subset_of(a));
+		ASSERT_TRUE(a.is_subset_of(a));
+		ASSERT_FALSE(a.is_proper_subset_of(a));
+		ASSERT_FALSE(a.is_subset_of(b));
+		ASSERT_TRUE(a.is_intersects(b));
+		ASSERT_FALSE(a_sub_b.is_intersects(b));
+
+		// only the last bit differs, no early exit can help
+		auto almost_a = a;
+		almost_a.reset(bits - 1);
+		ASSERT_TRUE(a.test(bits - 1) ? almost_a.is_proper_subset_of(a) : almost_a.is_subset_of(a));
+		auto a_and_last = a_sub_b;
+		a_and_last.set(bits - 1);
+		ASSERT_TRUE(a_and_last.is_intersects(b) == b.test(bits - 1));
+	}
+
+	// every kernel the cpu supports
+	std::vector<std::uint64_t> lhs(3 * 64 + 5);
+	std::vector<std::uint64_t> rhs(lhs.size());
+	for (std::size_t i = 0; i < lhs.size(); ++i)
+	{
+		lhs[i] = 0x9e3779b97f4a7c15ull * (i + 1);
+		rhs[i] = 0xbf58476d1ce4e5b9ull * (i + 3);
+	}
+
+	using kernel_type = void (*)(std::uint64_t*, const std::uint64_t*, std::size_t) noexcept;
+	const auto check_transform = [&]<details::block_operation Operation>(const kernel_type kernel) {
+		auto expected = lhs;
+		details::transform_scalar<Operation>(expected.data(), rhs.data(), expected.size());
+		auto result = lhs;
+		kernel(result.data(), rhs.data(), result.size());
+		ASSERT_EQ(result, expected);
+	};
+	using any_kernel_type = bool (*)(const std::uint64_t*, const std::uint64_t*, std::size_t) noexcept;
+	const auto check_any = [&]<details::block_operation Operation>(const any_kernel_type kernel) {
+		std::vector<std::uint64_t> zero(lhs.size());
+		ASSERT_FALSE(kernel(zero.data(), rhs.data(), zero.size()));
+		for (const std::size_t index: {std::size_t{0}, std::size_t{9}, zero.size() - 1})
+		{
+			// only one block gets a bit that makes the result true
+			auto one = zero;
+			one[index] = 1;
+			auto other = zero;
+			ASSERT_EQ(kernel(one.data(), other.data(), one.size()), details::any_scalar<Operation>(one.data(), other.data(), one.size())) << index;
+			ASSERT_EQ(kernel(one.data(), one.data(), one.size()), details::any_scalar<Operation>(one.data(), one.data(), one.size())) << index;
+		}
+	};
+
+	check_transform.operator()<details::block_operation::bit_and>(details::transform<details::block_operation::bit_and>);
+	check_transform.operator()<details::block_operation::bit_or>(details::transform<details::block_operation::bit_or>);
+	check_transform.operator()<details::block_operation::bit_xor>(details::transform<details::block_operation::bit_xor>);
+	check_transform.operator()<details::block_operation::bit_and_not>(details::transform<details::block_operation::bit_and_not>);
+	check_any.operator()<details::block_operation::bit_and>(details::any<details::block_operation::bit_and>);
+	check_any.operator()<details::block_operation::bit_and_not>(details::any<details::block_operation::bit_and_not>);
+
+	#ifdef GAL_CPU_X86
+	const auto& feature = gal::toolbox::utils::this_cpu_feature();
+	if (feature.sse2)
+	{
+		check_transform.operator()<details::block_operation::bit_and>(details::transform_sse2<details::block_operation::bit_and>);
+		check_transform.operator()<details::block_operation::bit_or>(details::transform_sse2<details::block_operation::bit_or>);
+		check_transform.operator()<details::block_operation::bit_xor>(details::transform_sse2<details::block_operation::bit_xor>);
+		check_transform.operator()<details::block_operation::bit_and_not>(details::transform_sse2<details::block_operation::bit_and_not>);
+		check_any.operator()<details::block_operation::bit_and>(details::any_sse2<details::block_operation::bit_and>);
+		check_any.operator()<details::block_operation::bit_and_not>(details::any_sse2<details::block_operation::bit_and_not>);
+	}
+	if (feature.avx2)
+	{
+		check_transform.operator()<details::block_operation::bit_and>(details::transform_avx2<details::block_operation::bit_and>);
+		check_transform.operator()<details::block_operation::bit_or>(details::transform_avx2<details::block_operation::bit_or>);
+		check_transform.operator()<details::block_operation::bit_xor>(details::transform_avx2<details::block_operation::bit_xor>);
+		check_transform.operator()<details::block_operation::bit_and_not>(details::transform_avx2<details::block_operation::bit_and_not>);
+		check_any.operator()<details::block_operation::bit_and>(details::any_avx2<details::block_operation::bit_and>);
+		check_any.operator()<details::block_operation::bit_and_not>(details::any_avx2<details::block_operation::bit_and_not>);
+	}
+	#endif
+}
+
+TEST(TestDynamicBitset, TestExpression)
+{
+	using size_type = basic_dynamic_bitset::size_type;
+
+	for (const size_type bits: {size_type{1}, size_type{64}, size_type{100}, size_type{256 * 64 * 2 + 3 * 64 + 17}})
+	{
+		basic_dynamic_bitset a(bits);
+		basic_dynamic_bitset b(bits);
+		basic_dynamic_bitset c(bits);
+		basic_dynamic_bitset d(bits);
+		for (size_type i = 0; i < bits; ++i)
+		{
+			if (i % 2 == 0) { a.set(i); }
+			if (i % 3 == 0) { b.set(i); }
+			if (i % 5 == 0) { c.set(i); }
+			if (i % 7 == 0) { d.set(i); }
+		}
+
+		const auto expected = [&](const size_type i) { return (a.test(i) and b.test(i)) or (c.test(i) and not d.test(i)); };
+
+		const basic_dynamic_bitset result = (a & b) | (c & ~d);
+		ASSERT_EQ(result.size(), bits);
+
+		size_type expected_count = 0;
+		for (size_type i = 0; i < bits; ++i)
+		{
+			ASSERT_EQ(result.test(i), expected(i)) << bits << ' ' << i;
+			expected_count += expected(i);
+		}
+		ASSERT_EQ(result.count(), expected_count);
+		ASSERT_EQ(count_of((a & b) | (c & ~d)), expected_count);
+		ASSERT_EQ(count_of(result), expected_count);
+
+		// the unused bits set by compl must not leak out
+		const basic_dynamic_bitset flipped = ~a;
+		ASSERT_EQ(flipped.count(), bits - a.count());
+		ASSERT_EQ(count_of(~a), bits - a.count());
+		ASSERT_EQ(count_of(~~a), a.count());
+
+		// an rvalue operand is owned by the expression
+		const auto owning = basic_dynamic_bitset{a} ^ b;
+		basic_dynamic_bitset xor_result(bits);
+		xor_result = owning;
+		for (size_type i = 0; i < bits; ++i) { ASSERT_EQ(xor_result.test(i), a.test(i) not_eq b.test(i)); }
+
+		// assign to one of the operands
+		auto self = c;
+		self = self - d;
+		for (size_type i = 0; i < bits; ++i) { ASSERT_EQ(self.test(i), c.test(i) and not d.test(i)); }
+
+		// assign to a bitset of another size
+		basic_dynamic_bitset resized;
+		resized = a | b;
+		ASSERT_EQ(resized.size(), bits);
+		ASSERT_EQ(resized, basic_dynamic_bitset{a} |= b);
+	}
+}
+
+TEST(TestDynamicBitset, TestFind)
+{
+	using size_type = basic_dynamic_bitset::size_type;
+	constexpr auto npos = basic_dynamic_bitset::npos;
+	static_assert(std::forward_iterator<basic_dynamic_bitset::set_bit_iterator>);
+	static_assert(std::ranges::view<decltype(std::declval<const basic_dynamic_bitset&>().set_bits())>);
+
+	basic_dynamic_bitset empty_bitset;
+	ASSERT_EQ(empty_bitset.find_first(), npos);
+	ASSERT_EQ(empty_bitset.find_last(), npos);
+	ASSERT_EQ(empty_bitset.find_next(0), npos);
+	ASSERT_EQ(empty_bitset.find_prev(0), npos);
+	ASSERT_TRUE(empty_bitset.set_bits().empty());
+
+	for (const size_type bits: {size_type{1}, size_type{64}, size_type{130}, size_type{10000}})
+	{
+		basic_dynamic_bitset bitset(bits);
+		ASSERT_EQ(bitset.find_first(), npos);
+		ASSERT_EQ(bitset.find_last(), npos);
+		ASSERT_TRUE(bitset.set_bits().empty());
+
+		// sparse, with some whole empty blocks and both ends of the blocks
+		std::vector<size_type> expected;
+		for (size_type i = 0; i < bits; ++i)
+		{
+			if (i == 0 or i == bits - 1 or i % 997 == 63 or i % 1009 == 64)
+			{
+				bitset.set(i);
+				expected.push_back(i);
+			}
+		}
+
+		ASSERT_EQ(bitset.find_first(), expected.front());
+		ASSERT_EQ(bitset.find_last(), expected.back());
+
+		std::vector<size_type> forward;
+		for (auto pos = bitset.find_first(); pos not_eq npos; pos = bitset.find_next(pos)) { forward.push_back(pos); }
+		ASSERT_EQ(forward, expected);
+
+		std::vector<size_type> backward;
+		for (auto pos = bitset.find_last(); pos not_eq npos; pos = bitset.find_prev(pos)) { backward.insert(backward.begin(), pos); }
+		ASSERT_EQ(backward, expected);
+
+		std::vector<size_type> view;
+		for (const auto pos: bitset.set_bits()) { view.push_back(pos); }
+		ASSERT_EQ(view, expected);
+		ASSERT_EQ(static_cast<size_type>(std::ranges::distance(bitset.set_bits())), bitset.count());
+
+		// out of range
+		ASSERT_EQ(bitset.find_next(bits - 1), npos);
+		ASSERT_EQ(bitset.find_next(npos), npos);
+		ASSERT_EQ(bitset.find_prev(npos), expected.back());
+	}
+}
+
+TEST(TestDynamicBitset, TestShift)
+{
+	using size_type = basic_dynamic_bitset::size_type;
+
+	const auto make = [](const size_type bits)
+	{
+		basic_dynamic_bitset bitset(bits);
+		for (size_type i = 0; i < bits; ++i) { if ((i * 7 + 3) % 5 < 2 or i % 61 == 0) { bitset.set(i); } }
+		return bitset;
+	};
+
+	// the size of the blocks covers the scalar kernel and the vector kernel with its tails
+	for (const size_type bits: {size_type{1}, size_type{64}, size_type{100}, size_type{1000}, size_type{64 * 64 + 37}})
+	{
+		const auto origin = make(bits);
+
+		for (const size_type n: {size_type{0}, size_type{1}, size_type{3}, size_type{63}, size_type{64}, size_type{65}, size_type{128}, size_type{130}, size_type{999}, bits - 1, bits, bits + 1})
+		{
+			auto left = origin;
+			left <<= n;
+			auto right = origin;
+			right >>= n;
+			auto rotate_left = origin;
+			rotate_left.rotate_left(n);
+			auto rotate_right = origin;
+			rotate_right.rotate_right(n);
+			auto window = origin;
+			window.shift_and_or(make(bits) >>= 1, n);
+
+			for (size_type i = 0; i < bits; ++i)
+			{
+				ASSERT_EQ(left.test(i), i >= n and origin.test(i - n)) << bits << ' ' << n << ' ' << i;
+				ASSERT_EQ(right.test(i), n < bits and i < bits - n and origin.test(i + n)) << bits << ' ' << n << ' ' << i;
+				ASSERT_EQ(rotate_left.test(i), origin.test((i + bits - n % bits) % bits)) << bits << ' ' << n << ' ' << i;
+				ASSERT_EQ(rotate_right.test(i), origin.test((i + n) % bits)) << bits << ' ' << n << ' ' << i;
+				ASSERT_EQ(window.test(i), (i >= n and origin.test(i - n)) or (i + 1 < bits and origin.test(i + 1))) << bits << ' ' << n << ' ' << i;
+			}
+			ASSERT_EQ(left, origin << n);
+			ASSERT_EQ(right, origin >> n);
+		}
+	}
+
+	// every kernel the cpu supports
+	std::vector<std::uint64_t> src(3 * 64 + 5);
+	for (std::size_t i = 0; i < src.size(); ++i) { src[i] = 0x9e3779b97f4a7c15ull * (i + 1); }
+
+	using kernel_type = void (*)(std::uint64_t*, std::size_t, const std::uint64_t*, std::size_t, std::size_t, const std::uint64_t*) noexcept;
+	const auto check = [&src](const kernel_type kernel, const kernel_type scalar)
+	{
+		for (const std::size_t dst_size: {std::size_t{1}, std::size_t{64}, src.size(), src.size() + 9})
+		{
+			for (const std::size_t n: {std::size_t{0}, std::size_t{1}, std::size_t{64}, std::size_t{64 * 3 + 17}, src.size() * 64 + 1})
+			{
+				std::vector<std::uint64_t> merge(dst_size, 0x0101010101010101ull);
+				std::vector<std::uint64_t> expected(dst_size);
+				std::vector<std::uint64_t> result(dst_size);
+				scalar(expected.data(), dst_size, src.data(), src.size(), n, merge.data());
+				kernel(result.data(), dst_size, src.data(), src.size(), n, merge.data());
+				ASSERT_EQ(result, expected) << dst_size << ' ' << n;
+
+				// in place
+				if (dst_size == src.size())
+				{
+					auto self = src;
+					kernel(self.data(), self.size(), self.data(), self.size(), n, merge.data());
+					ASSERT_EQ(self, expected) << n;
+				}
+			}
+		}
+	};
+
+	check(details::shift_left<true>, details::shift_left_scalar<true>);
+	check(details::shift_right<true>, details::shift_right_scalar<true>);
+	check([](auto* dst, auto dst_size, auto* src, auto src_size, auto n, auto*) noexcept { details::shift_left<false>(dst, dst_size, src, src_size, n); },
+	      [](auto* dst, auto dst_size, auto* src, auto src_size, auto n, auto*) noexcept { details::shift_left_scalar<false>(dst, dst_size, src, src_size, n, nullptr); });
+	check([](auto* dst, auto dst_size, auto* src, auto src_size, auto n, auto*) noexcept { details::shift_right<false>(dst, dst_size, src, src_size, n); },
+	      [](auto* dst, auto dst_size, auto* src, auto src_size, auto n, auto*) noexcept { details::shift_right_scalar<false>(dst, dst_size, src, src_size, n, nullptr); });
+	#ifdef GAL_CPU_X86
+	if (gal::toolbox::utils::this_cpu_feature().avx2)
+	{
+		check(details::shift_left_avx2<true>, details::shift_left_scalar<true>);
+		check(details::shift_right_avx2<true>, details::shift_right_scalar<true>);
+		check(details::shift_left_avx2<false>, details::shift_left_scalar<false>);
+		check(details::shift_right_avx2<false>, details::shift_right_scalar<false>);
+	}
+	#endif
+}
+
+TEST(TestDynamicBitset, TestSmallBuffer)
+{
+	using size_type = basic_dynamic_bitset::size_type;
+	constexpr auto inline_bits = basic_dynamic_bitset::container::inline_size * basic_dynamic_bitset::bits_of_type;
+
+	basic_dynamic_bitset bitset;
+	std::vector<bool> expected;
+	ASSERT_EQ(bitset.capacity(), inline_bits);
+
+	const auto check = [&]
+	{
+		ASSERT_EQ(bitset.size(), expected.size());
+		for (size_type i = 0; i < expected.size(); ++i) { ASSERT_EQ(bitset.test(i), expected[i]) << i; }
+		ASSERT_EQ(bitset.count(), static_cast<size_type>(std::ranges::count(expected, true)));
+	};
+
+	// grow across the inline/heap boundary and shrink back
+	for (size_type i = 0; i < inline_bits * 3; ++i)
+	{
+		bitset.push_back(i % 3 == 0);
+		expected.push_back(i % 3 == 0);
+	}
+	check();
+	auto iterator = bitset.begin();
+	for (size_type i = 0; i < expected.size(); ++i, ++iterator) { ASSERT_EQ(static_cast<bool>(*iterator), expected[i]) << i; }
+
+	while (bitset.size() > inline_bits / 2)
+	{
+		bitset.pop_back();
+		expected.pop_back();
+	}
+	check();
+
+	bitset.resize(inline_bits + 1, true);
+	expected.resize(inline_bits + 1, true);
+	check();
+	bitset.resize(inline_bits - 1);
+	expected.resize(inline_bits - 1);
+	check();
+
+	// a moved-from bitset is empty whether its blocks were inline or on the heap
+	for (const size_type bits: {inline_bits, inline_bits * 2})
+	{
+		basic_dynamic_bitset origin(bits);
+		origin.set();
+		auto moved = std::move(origin);
+		ASSERT_EQ(moved.count(), bits);
+		// NOLINTNEXTLINE(bugprone-use-after-move)
+		ASSERT_TRUE(origin.empty());
+
+		auto copied = moved;
+		copied.reset(0);
+		ASSERT_NE(copied, moved);
+		ASSERT_EQ(copied.count(), bits - 1);
+	}
+
+	basic_dynamic_bitset heap(inline_bits * 2);
+	heap.set(inline_bits + 1);
+	heap.swap(bitset);
+	ASSERT_EQ(heap.size(), expected.size());
+	ASSERT_EQ(bitset.size(), inline_bits * 2);
+	ASSERT_EQ(bitset.find_first(), inline_bits + 1);
+	bitset = heap;
+	check();
+
+	bitset.clear();
+	bitset.shrink_to_fit();
+	ASSERT_EQ(bitset.capacity(), inline_bits);
+}
+
+TEST(TestDynamicBitset, TestSerialize)
+{
+	using size_type = basic_dynamic_bitset::size_type;
+
+	const auto make = [](const size_type bits)
+	{
+		basic_dynamic_bitset bitset(bits);
+		// some noise, then long runs of 0 and 1
+		for (size_type i = 0; i < bits; ++i) { if ((i / 5000) % 2 == 1 or (i < 1000 and i % 97 == 0)) { bitset.set(i); } }
+		return bitset;
+	};
+
+	const auto to_hex = [](const basic_dynamic_bitset& bitset)
+	{
+		// 4 chars of to_string per digit, pad the highest digit
+		auto str = bitset.to_string();
+		str.insert(0, (4 - str.size() % 4) % 4, '0');
+		std::string hex;
+		for (size_type i = 0; i < str.size(); i += 4) { hex.push_back("0123456789abcdef"[std::stoi(str.substr(i, 4), nullptr, 2)]); }
+		return hex;
+	};
+
+	for (const size_type bits: {size_type{0}, size_type{1}, size_type{63}, size_type{64}, size_type{65}, size_type{1000}, size_type{64 * 300 + 5}})
+	{
+		const auto origin = make(bits);
+
+		for (const auto encoding: {dynamic_bitset_encoding::raw, dynamic_bitset_encoding::run_length})
+		{
+			std::vector<std::byte> buffer(origin.serialized_size(encoding));
+			ASSERT_EQ(origin.serialize(buffer, encoding), buffer.size());
+
+			size_type read = 0;
+			const auto from_buffer = basic_dynamic_bitset::deserialize(buffer, &read);
+			ASSERT_TRUE(from_buffer.has_value()) << bits;
+			ASSERT_EQ(*from_buffer, origin);
+			ASSERT_EQ(read, buffer.size());
+
+			std::stringstream stream{std::ios_base::in bitor std::ios_base::out bitor std::ios_base::binary};
+			origin.serialize(stream, encoding);
+			ASSERT_EQ(stream.str().size(), buffer.size());
+			const auto from_stream = basic_dynamic_bitset::deserialize(stream);
+			ASSERT_TRUE(from_stream.has_value()) << bits;
+			ASSERT_EQ(*from_stream, origin);
+
+			// truncated
+			if (bits not_eq 0) { ASSERT_FALSE(basic_dynamic_bitset::deserialize(std::span{buffer}.first(buffer.size() - 1)).has_value()); }
+		}
+		// the runs are much smaller than the blocks
+		if (bits > 1000) { ASSERT_LT(origin.serialized_size(dynamic_bitset_encoding::run_length) * 4, origin.serialized_size()); }
+
+		const auto hex = origin.to_hex();
+		ASSERT_EQ(hex, to_hex(origin)) << bits;
+		ASSERT_EQ(hex.size(), origin.hex_size());
+
+		std::ostringstream stream;
+		origin.to_hex(stream);
+		ASSERT_EQ(stream.str(), hex);
+
+		const auto from_hex = basic_dynamic_bitset::from_hex(hex, bits);
+		ASSERT_TRUE(from_hex.has_value()) << bits;
+		ASSERT_EQ(*from_hex, origin);
+		ASSERT_EQ(basic_dynamic_bitset::from_hex(hex)->count(), origin.count());
+	}
+
+	// corrupted data
+	const auto origin = make(1000);
+	std::vector<std::byte> buffer(origin.serialized_size());
+	origin.serialize(buffer);
+	// an unknown encoding
+	buffer[8] = std::byte{42};
+	ASSERT_FALSE(basic_dynamic_bitset::deserialize(buffer).has_value());
+	// a set bit past the size
+	buffer[8] = std::byte{0};
+	buffer.back() = std::byte{0xff};
+	ASSERT_FALSE(basic_dynamic_bitset::deserialize(buffer).has_value());
+	{
+		std::stringstream stream{std::ios_base::in bitor std::ios_base::out bitor std::ios_base::binary};
+		stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+		ASSERT_FALSE(basic_dynamic_bitset::deserialize(stream).has_value());
+	}
+
+	// a huge bit count in the header is rejected without allocating it
+	for (const auto encoding: {dynamic_bitset_encoding::raw, dynamic_bitset_encoding::run_length})
+	{
+		std::vector<std::byte> bogus(origin.serialized_size(encoding));
+		origin.serialize(bogus, encoding);
+		bogus[7] = std::byte{0x40};
+		ASSERT_FALSE(basic_dynamic_bitset::deserialize(bogus).has_value());
+
+		std::stringstream stream{std::ios_base::in bitor std::ios_base::out bitor std::ios_base::binary};
+		stream.write(reinterpret_cast<const char*>(bogus.data()), static_cast<std::streamsize>(bogus.size()));
+		ASSERT_FALSE(basic_dynamic_bitset::deserialize(stream).has_value());
+		ASSERT_TRUE(stream.fail());
+	}
+
+	// upper case, invalid digits, and bits past the size
+	ASSERT_EQ(basic_dynamic_bitset::from_hex("A5")->to_string(), "10100101");
+	ASSERT_EQ(basic_dynamic_bitset::from_hex("05", 5)->to_string(), "00101");
+	ASSERT_FALSE(basic_dynamic_bitset::from_hex("25", 5).has_value());
+	ASSERT_FALSE(basic_dynamic_bitset::from_hex("0g").has_value());
+	ASSERT_FALSE(basic_dynamic_bitset::from_hex(std::string(1000, '0') + "x" + std::string(1000, '0')).has_value());
+	ASSERT_FALSE(basic_dynamic_bitset::from_hex("00", 9).has_value());
+
+	// every kernel the cpu supports
+	std::vector<std::uint64_t> blocks(3 * 64 + 5);
+	for (std::size_t i = 0; i < blocks.size(); ++i) { blocks[i] = 0x9e3779b97f4a7c15ull * (i + 1); }
+	std::string expected(blocks.size() * 16, ' ');
+	gal::toolbox::container::details::hex_encode_scalar(blocks.data(), blocks.size(), expected.data());
+	for (auto& c: expected) { if (&c - expected.data() < 200 and c >= 'a') { c = static_cast<char>(c - 'a' + 'A'); } }
+
+	std::string result(expected.size(), ' ');
+	std::vector<std::uint64_t> decoded(blocks.size());
+	#ifdef GAL_CPU_X86
+	if (gal::toolbox::utils::this_cpu_feature().avx2)
+	{
+		gal::toolbox::container::details::hex_encode_avx2(blocks.data(), blocks.size(), result.data());
+		ASSERT_TRUE(std::ranges::equal(result, expected, [](const char a, const char b) { return std::tolower(a) == std::tolower(b); }));
+		ASSERT_TRUE(gal::toolbox::container::details::hex_decode_avx2(expected.data(), blocks.size(), decoded.data()));
+		ASSERT_EQ(decoded, blocks);
+		expected[100] = 'G';
+		ASSERT_FALSE(gal::toolbox::container::details::hex_decode_avx2(expected.data(), blocks.size(), decoded.data()));
+		expected[100] = '0';
+		expected[expected.size() - 1] = '/';
+		ASSERT_FALSE(gal::toolbox::container::details::hex_decode_avx2(expected.data(), blocks.size(), decoded.data()));
+	}
+	#endif
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/container/dynamic_ring_buffer.hpp>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace gal::toolbox::container;
+
+TEST(TestDynamicRingBuffer, TestCapacity)
+{
+	dynamic_ring_buffer<int> buffer_i1{1};
+	ASSERT_EQ(buffer_i1.capacity(), static_cast<decltype(buffer_i1.capacity())>(1));
+
+	dynamic_ring_buffer<int> buffer_i5{5};
+	ASSERT_EQ(buffer_i5.capacity(), static_cast<decltype(buffer_i5.capacity())>(8));
+	ASSERT_FALSE(buffer_i5.mirrored());
+
+	dynamic_ring_buffer<int> buffer_i4096{4096};
+	ASSERT_EQ(buffer_i4096.capacity(), static_cast<decltype(buffer_i4096.capacity())>(4096));
+}
+
+TEST(TestDynamicRingBuffer, TestPushAndPop)
+{
+	dynamic_ring_buffer<std::string> buffer_s3{3};
+
+	ASSERT_TRUE(buffer_s3.empty());
+	ASSERT_TRUE(buffer_s3.push("one"));
+	ASSERT_TRUE(buffer_s3.push("two"));
+	ASSERT_TRUE(buffer_s3.push("three"));
+	ASSERT_TRUE(buffer_s3.push("four"));
+	ASSERT_TRUE(buffer_s3.full());
+	ASSERT_FALSE(buffer_s3.push("five"));
+
+	std::string data;
+	ASSERT_TRUE(buffer_s3.pop(data));
+	ASSERT_EQ(data, "one");
+	ASSERT_TRUE(buffer_s3.push("five"));
+	ASSERT_EQ(buffer_s3.front(), "two");
+	ASSERT_EQ(buffer_s3.back(), "five");
+
+	auto copy{buffer_s3};
+	ASSERT_EQ(copy.size(), buffer_s3.size());
+	for (decltype(copy.size()) i = 0; i < copy.size(); ++i) { ASSERT_EQ(copy[i], buffer_s3[i]); }
+
+	auto moved{std::move(copy)};
+	ASSERT_EQ(moved.size(), static_cast<decltype(moved.size())>(4));
+	ASSERT_EQ(moved[3], "five");
+
+	// assigning from a larger buffer takes its capacity
+	dynamic_ring_buffer<std::string> small{1};
+	ASSERT_TRUE(small.push("zero"));
+	small = moved;
+	ASSERT_EQ(small.capacity(), moved.capacity());
+	ASSERT_EQ(small.size(), moved.size());
+	for (decltype(small.size()) i = 0; i < small.size(); ++i) { ASSERT_EQ(small[i], moved[i]); }
+}
+
+TEST(TestDynamicRingBuffer, TestBulk)
+{
+	for (const auto storage: {dynamic_ring_buffer<int>::storage_type::heap, dynamic_ring_buffer<int>::storage_type::mirrored})
+	{
+		dynamic_ring_buffer<int> buffer{100, storage};
+		const auto capacity = buffer.capacity();
+
+		std::vector<int> in(capacity);
+		std::iota(in.begin(), in.end(), 0);
+
+		// move the head to the middle, so the next bulk push wraps around
+		ASSERT_EQ(buffer.push_bulk(in.data(), capacity / 2), capacity / 2);
+		std::vector<int> out(capacity);
+		ASSERT_EQ(buffer.pop_bulk(out.data(), capacity / 2), capacity / 2);
+		ASSERT_TRUE(buffer.empty());
+
+		ASSERT_EQ(buffer.push_bulk(in.data(), capacity + 10), capacity);
+		ASSERT_TRUE(buffer.full());
+		for (decltype(buffer.size()) i = 0; i < buffer.size(); ++i) { ASSERT_EQ(buffer[i], in[i]); }
+
+		std::ranges::fill(out, -1);
+		ASSERT_EQ(buffer.pop_bulk(out.data(), capacity), capacity);
+		ASSERT_EQ(out, in);
+		ASSERT_TRUE(buffer.empty());
+
+		#if defined(__linux__)
+		if (storage == dynamic_ring_buffer<int>::storage_type::mirrored) { ASSERT_TRUE(buffer.mirrored()); }
+		#endif
+	}
+}
+
+TEST(TestDynamicRingBuffer, TestSpans)
+{
+	for (const auto storage: {dynamic_ring_buffer<char>::storage_type::heap, dynamic_ring_buffer<char>::storage_type::mirrored})
+	{
+		dynamic_ring_buffer<char> buffer{8, storage};
+		const auto capacity = buffer.capacity();
+
+		// move the head near the end
+		buffer.commit(capacity - 2);
+		buffer.consume(capacity - 2);
+
+		const std::string_view in{"abcdef"};
+		auto writable = buffer.writable_spans();
+		ASSERT_EQ(writable[0].size() + writable[1].size(), capacity);
+		if (buffer.mirrored()) { ASSERT_TRUE(writable[1].empty()); }
+		else { ASSERT_EQ(writable[0].size(), static_cast<decltype(writable[0].size())>(2)); }
+
+		auto it = in.begin();
+		for (auto span: writable)
+		{
+			for (auto& c: span)
+			{
+				if (it == in.end()) { break; }
+				c = *it++;
+			}
+		}
+		buffer.commit(in.size());
+
+		std::string out;
+		for (const auto span: std::as_const(buffer).readable_spans()) { out.append(span.begin(), span.end()); }
+		ASSERT_EQ(out, in);
+	}
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
 #include <galToolbox/container/fifo.hpp>
+#include <thread>
+#include <vector>
 
 using namespace gal::toolbox::container;
 
@@ -41,3 +43,132 @@ TEST(TestFifo, TestPushAndPop)
 	ASSERT_FALSE(fifo_f16.pop(1000));
 	ASSERT_TRUE(fifo_f16.empty());
 }
+
+TEST(TestFifo, TestBulkPushAndPop)
+{
+	fifo<int, 8> fifo_i8{};
+
+	const std::vector<int> data{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+	// only 8 slots are available
+	ASSERT_EQ(fifo_i8.push_bulk(data), static_cast<decltype(fifo_i8.size())>(8));
+	ASSERT_TRUE(fifo_i8.full());
+	ASSERT_EQ(fifo_i8.push_bulk(data), static_cast<decltype(fifo_i8.size())>(0));
+
+	std::vector<int> out;
+	ASSERT_EQ(fifo_i8.pop_bulk(std::back_inserter(out), 3), static_cast<decltype(fifo_i8.size())>(3));
+	ASSERT_EQ(out, (std::vector<int>{0, 1, 2}));
+
+	// wrap around
+	ASSERT_EQ(fifo_i8.push_bulk(data | std::views::drop(8)), static_cast<decltype(fifo_i8.size())>(2));
+	ASSERT_EQ(fifo_i8.size(), static_cast<decltype(fifo_i8.size())>(7));
+
+	out.clear();
+	ASSERT_EQ(fifo_i8.pop_bulk(std::back_inserter(out), 100), static_cast<decltype(fifo_i8.size())>(7));
+	ASSERT_EQ(out, (std::vector<int>{3, 4, 5, 6, 7, 8, 9}));
+
+	ASSERT_TRUE(fifo_i8.empty());
+	ASSERT_EQ(fifo_i8.pop_bulk(std::back_inserter(out), 100, 10), static_cast<decltype(fifo_i8.size())>(0));
+}
+
+TEST(TestFifo, TestPaddedSlot)
+{
+	struct foo
+	{
+		int a;
+		int b;
+	};
+
+	using fifo_type = fifo<foo, 4, std::allocator<foo>, true>;
+	static_assert(alignof(typename fifo_type::internal_type::value_type) >= gal::toolbox::utils::cache_line_size);
+
+	fifo_type fifo_f4{};
+
+	ASSERT_TRUE(fifo_f4.push(1, 2));
+	ASSERT_TRUE(fifo_f4.push(3, 4));
+	ASSERT_EQ(fifo_f4.size(), static_cast<decltype(fifo_f4.size())>(2));
+
+	foo foo1{};
+	ASSERT_TRUE(fifo_f4.pop(foo1));
+	ASSERT_EQ(foo1.a, 1);
+	ASSERT_EQ(foo1.b, 2);
+	ASSERT_TRUE(fifo_f4.pop(foo1));
+	ASSERT_EQ(foo1.a, 3);
+	ASSERT_EQ(foo1.b, 4);
+
+	const std::vector<foo> data{{4, 5}, {6, 7}};
+	ASSERT_EQ(fifo_f4.push_bulk(data), static_cast<decltype(fifo_f4.size())>(2));
+
+	std::vector<foo> out;
+	ASSERT_EQ(fifo_f4.pop_bulk(std::back_inserter(out), 4), static_cast<decltype(fifo_f4.size())>(2));
+	ASSERT_EQ(out[0].a, 4);
+	ASSERT_EQ(out[1].b, 7);
+	ASSERT_TRUE(fifo_f4.empty());
+}
+
+TEST(TestFifo, TestPushForce)
+{
+	fifo<int, 4> fifo_i4{};
+
+	for (int i = 0; i < 10; ++i) { fifo_i4.push_force(i); }
+	ASSERT_TRUE(fifo_i4.full());
+	ASSERT_EQ(fifo_i4.size(), static_cast<decltype(fifo_i4.size())>(4));
+	ASSERT_EQ(fifo_i4.dropped(), static_cast<decltype(fifo_i4.dropped())>(6));
+
+	// keep the latest 4
+	int data{};
+	for (int i = 6; i < 10; ++i)
+	{
+		ASSERT_TRUE(fifo_i4.pop(data));
+		ASSERT_EQ(data, i);
+	}
+	ASSERT_TRUE(fifo_i4.empty());
+}
+
+template<typename Fifo>
+void blocking_producer_consumer()
+{
+	constexpr int total = 20000;
+
+	Fifo fifo{};
+
+	std::thread producer{
+			[&fifo]
+			{
+				for (int i = 0; i < total; ++i)
+				{
+					while (not fifo.push(i)) { std::this_thread::yield(); }
+					// let the consumer run dry and park from time to time
+					if (i % 1000 == 0) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+				}
+			}};
+
+	long long sum = 0;
+	int data{};
+	for (int i = 0; i < total; ++i)
+	{
+		ASSERT_TRUE(fifo.pop(data));
+		ASSERT_EQ(data, i);
+		sum += data;
+	}
+	producer.join();
+
+	ASSERT_EQ(sum, static_cast<long long>(total) * (total - 1) / 2);
+	ASSERT_TRUE(fifo.empty());
+
+	// nothing to pop, wait for a while and then give up
+	ASSERT_FALSE(fifo.pop(data, 10));
+	ASSERT_FALSE(fifo.pop(data, static_cast<typename Fifo::time_type>(-1)));
+}
+
+TEST(TestFifo, TestConditionVariableWait)
+{
+	blocking_producer_consumer<fifo<int, 64>>();
+}
+
+TEST(TestFifo, TestSpinThenPark)
+{
+	blocking_producer_consumer<fifo<int, 64, std::allocator<int>, false, fifo_spin_then_park_policy>>();
+	// park immediately
+	blocking_producer_consumer<fifo<int, 64, std::allocator<int>, false, fifo_wait_policy<0, fifo_park_type::atomic_wait>>>();
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/container/mpmc_fifo.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gal::toolbox::container;
+
+TEST(TestMpmcFifo, TestPushAndPop)
+{
+	mpmc_fifo<int, 4> fifo_i4{};
+
+	ASSERT_TRUE(fifo_i4.empty());
+
+	ASSERT_TRUE(fifo_i4.push(1));
+	ASSERT_TRUE(fifo_i4.push(2));
+	ASSERT_TRUE(fifo_i4.push(3));
+	ASSERT_TRUE(fifo_i4.push(4));
+	ASSERT_EQ(fifo_i4.size(), static_cast<decltype(fifo_i4.size())>(4));
+	ASSERT_TRUE(fifo_i4.full());
+
+	// already full
+	ASSERT_FALSE(fifo_i4.push(5));
+
+	int data{};
+	ASSERT_TRUE(fifo_i4.try_pop(data));
+	ASSERT_EQ(data, 1);
+	ASSERT_TRUE(fifo_i4.push(5));
+
+	for (int i = 2; i <= 5; ++i)
+	{
+		ASSERT_TRUE(fifo_i4.try_pop(data));
+		ASSERT_EQ(data, i);
+	}
+
+	ASSERT_FALSE(fifo_i4.try_pop(data));
+	ASSERT_TRUE(fifo_i4.empty());
+}
+
+TEST(TestMpmcFifo, TestNonTrivial)
+{
+	mpmc_fifo<std::string, 8> fifo_s8{};
+
+	ASSERT_TRUE(fifo_s8.push("hello"));
+	ASSERT_TRUE(fifo_s8.push(std::string(100, 'x')));
+
+	std::string s;
+	ASSERT_TRUE(fifo_s8.try_pop(s));
+	ASSERT_EQ(s, "hello");
+
+	// the remaining string will be destroyed by the fifo
+}
+
+TEST(TestMpmcFifo, TestMultiProducerMultiConsumer)
+{
+	constexpr int producers = 4;
+	constexpr int consumers = 4;
+	constexpr int per_producer = 20000;
+
+	mpmc_fifo<int, 128> fifo_i128{};
+
+	std::atomic<long long> sum{0};
+	std::atomic<int> consumed{0};
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+	{
+		threads.emplace_back(
+				[&fifo_i128, p]
+				{
+					for (int i = 0; i < per_producer; ++i)
+					{
+						while (not fifo_i128.push(p * per_producer + i)) { std::this_thread::yield(); }
+					}
+				});
+	}
+	for (int c = 0; c < consumers; ++c)
+	{
+		threads.emplace_back(
+				[&]
+				{
+					int data{};
+					while (consumed.load() < producers * per_producer)
+					{
+						if (fifo_i128.try_pop(data))
+						{
+							sum += data;
+							++consumed;
+						}
+						else { std::this_thread::yield(); }
+					}
+				});
+	}
+
+	for (auto& thread: threads) { thread.join(); }
+
+	constexpr long long total = static_cast<long long>(producers) * per_producer;
+	ASSERT_EQ(consumed.load(), total);
+	ASSERT_EQ(sum.load(), total * (total - 1) / 2);
+	ASSERT_TRUE(fifo_i128.empty());
+}
+
+TEST(TestMpmcFifo, TestOverwriteOldest)
+{
+	mpmc_fifo<std::string, 4, std::allocator<std::string>, fifo_overflow_policy::overwrite_oldest> fifo_s4{};
+
+	for (int i = 0; i < 10; ++i) { ASSERT_TRUE(fifo_s4.push(std::to_string(i))); }
+	ASSERT_TRUE(fifo_s4.full());
+	ASSERT_EQ(fifo_s4.dropped(), static_cast<decltype(fifo_s4.dropped())>(6));
+
+	// keep the latest 4
+	std::string s;
+	for (int i = 6; i < 10; ++i)
+	{
+		ASSERT_TRUE(fifo_s4.try_pop(s));
+		ASSERT_EQ(s, std::to_string(i));
+	}
+	ASSERT_FALSE(fifo_s4.try_pop(s));
+}
+
+TEST(TestMpmcFifo, TestOverwriteOldestMultiProducerMultiConsumer)
+{
+	constexpr int producers = 4;
+	constexpr int consumers = 2;
+	constexpr int per_producer = 20000;
+
+	mpmc_fifo<int, 64, std::allocator<int>, fifo_overflow_policy::overwrite_oldest> fifo_i64{};
+
+	std::atomic<int> finished{0};
+	std::atomic<int> consumed{0};
+
+	std::vector<std::thread> threads;
+	for (int p = 0; p < producers; ++p)
+	{
+		threads.emplace_back(
+				[&]
+				{
+					// producers never fail
+					for (int i = 0; i < per_producer; ++i) { if (not fifo_i64.push(i)) { return; } }
+					++finished;
+				});
+	}
+	for (int c = 0; c < consumers; ++c)
+	{
+		threads.emplace_back(
+				[&]
+				{
+					int data{};
+					while (finished.load() != producers or not fifo_i64.empty())
+					{
+						if (fifo_i64.try_pop(data)) { ++consumed; }
+						else { std::this_thread::yield(); }
+					}
+				});
+	}
+
+	for (auto& thread: threads) { thread.join(); }
+
+	ASSERT_EQ(finished.load(), producers);
+	// every element is either consumed or dropped
+	ASSERT_EQ(static_cast<std::size_t>(consumed.load()) + fifo_i64.dropped(), static_cast<std::size_t>(producers) * per_producer);
+	ASSERT_TRUE(fifo_i64.empty());
+}
@@ -232,3 +232,33 @@ TEST(TestRingBuffer, TestEqual)
 	ASSERT_EQ(buffer_i16_1, buffer_l16_1);
 	ASSERT_NE(buffer_l16_1, buffer_l16_2);
 }
+
+TEST(TestRingBuffer, TestSpans)
+{
+	ring_buffer<int, 8> buffer_i8{};
+
+	// write 6 elements from position 5, it wraps around after 3 elements
+	auto [first, second] = buffer_i8.writable_spans(5, 11);
+	ASSERT_EQ(first.size(), static_cast<decltype(first.size())>(3));
+	ASSERT_EQ(second.size(), static_cast<decltype(second.size())>(3));
+	for (int i = 0; i < 3; ++i)
+	{
+		first[i] = i;
+		second[i] = i + 3;
+	}
+	buffer_i8.commit(5, 6);
+	ASSERT_EQ(buffer_i8.size(), static_cast<decltype(buffer_i8.size())>(6));
+	for (int i = 0; i < 6; ++i) { ASSERT_EQ(buffer_i8[5 + i], i); }
+
+	const auto& const_buffer = buffer_i8;
+	const auto readable = const_buffer.readable_spans(6, 10);
+	ASSERT_EQ(readable[0].size(), static_cast<decltype(readable[0].size())>(2));
+	ASSERT_EQ(readable[1].size(), static_cast<decltype(readable[1].size())>(2));
+	ASSERT_EQ(readable[0][0], 1);
+	ASSERT_EQ(readable[1][1], 4);
+
+	buffer_i8.consume(5, 4);
+	ASSERT_EQ(buffer_i8.size(), static_cast<decltype(buffer_i8.size())>(2));
+	ASSERT_FALSE(buffer_i8.exist(5));
+	ASSERT_TRUE(buffer_i8.exist(9));
+}
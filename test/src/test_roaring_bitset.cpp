@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/container/roaring_bitset.hpp>
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace gal::toolbox::container;
+
+namespace
+{
+	using value_type = roaring_bitset::value_type;
+	using size_type = roaring_bitset::size_type;
+
+	std::vector<value_type> values_of(const roaring_bitset& bitset)
+	{
+		std::vector<value_type> values;
+		bitset.for_each([&values](const value_type value) { values.push_back(value); });
+		return values;
+	}
+
+	/**
+	 * @brief a sparse bucket (array), a dense bucket (bitmap), a bucket of long runs, and some values far away
+	 */
+	std::set<value_type> make_values(const unsigned seed)
+	{
+		std::mt19937 random{seed};
+		std::set<value_type> values;
+
+		for (int i = 0; i < 1000; ++i) { values.insert(static_cast<value_type>(random() % 65536)); }
+		for (int i = 0; i < 20000; ++i) { values.insert(65536 + static_cast<value_type>(random() % 65536)); }
+		for (value_type start = 2 * 65536 + random() % 100; start < 3 * 65536 - 1000; start += 1000 + random() % 1000)
+		{
+			for (value_type i = 0; i < 500; ++i) { values.insert(start + i); }
+		}
+		for (int i = 0; i < 100; ++i) { values.insert(static_cast<value_type>(random())); }
+
+		return values;
+	}
+
+	roaring_bitset make_bitset(const std::set<value_type>& values)
+	{
+		roaring_bitset bitset;
+		for (const auto value: values) { bitset.set(value); }
+		return bitset;
+	}
+}// namespace
+
+TEST(TestRoaringBitset, TestSetAndReset)
+{
+	roaring_bitset bitset{1, 3, 65536, 0xffff'ffff};
+
+	ASSERT_EQ(bitset.count(), static_cast<size_type>(4));
+	ASSERT_EQ(bitset.bucket_size(), static_cast<size_type>(3));
+	ASSERT_TRUE(bitset.test(65536));
+	ASSERT_FALSE(bitset.test(2));
+	ASSERT_EQ(bitset.min(), static_cast<value_type>(1));
+	ASSERT_EQ(bitset.max(), static_cast<value_type>(0xffff'ffff));
+
+	bitset.reset(65536);
+	ASSERT_FALSE(bitset.test(65536));
+	// the empty bucket is removed
+	ASSERT_EQ(bitset.bucket_size(), static_cast<size_type>(2));
+
+	bitset.flip(2);
+	ASSERT_TRUE(bitset.test(2));
+	ASSERT_EQ(values_of(bitset), (std::vector<value_type>{1, 2, 3, 0xffff'ffff}));
+
+	bitset.clear();
+	ASSERT_TRUE(bitset.empty());
+	ASSERT_EQ(bitset.count(), static_cast<size_type>(0));
+
+	// grow an array into a bitmap and shrink it back
+	for (value_type i = 0; i < 10000; ++i) { bitset.set(i * 3); }
+	ASSERT_EQ(bitset.count(), static_cast<size_type>(10000));
+	for (value_type i = 0; i < 10000; ++i) { ASSERT_TRUE(bitset.test(i * 3)) << i; }
+	for (value_type i = 0; i < 10000; i += 2) { bitset.reset(i * 3); }
+	ASSERT_EQ(bitset.count(), static_cast<size_type>(5000));
+	for (value_type i = 0; i < 10000; ++i) { ASSERT_EQ(bitset.test(i * 3), i % 2 == 1) << i; }
+	ASSERT_EQ(bitset.min(), static_cast<value_type>(3));
+	ASSERT_EQ(bitset.max(), static_cast<value_type>(9999 * 3));
+}
+
+TEST(TestRoaringBitset, TestOperation)
+{
+	const auto a_values = make_values(42);
+	const auto b_values = make_values(4242);
+	const auto a = make_bitset(a_values);
+	const auto b = make_bitset(b_values);
+
+	ASSERT_EQ(a.count(), a_values.size());
+	ASSERT_EQ(values_of(a), std::vector<value_type>(a_values.begin(), a_values.end()));
+
+	const auto check = [&](const roaring_bitset& result, auto algorithm)
+	{
+		std::vector<value_type> expected;
+		algorithm(a_values.begin(), a_values.end(), b_values.begin(), b_values.end(), std::back_inserter(expected));
+		ASSERT_EQ(values_of(result), expected);
+		ASSERT_EQ(result.count(), expected.size());
+	};
+
+	// with and without run containers
+	for (const bool optimize: {false, true})
+	{
+		auto lhs = a;
+		auto rhs = b;
+		if (optimize)
+		{
+			ASSERT_TRUE(lhs.run_optimize());
+			ASSERT_TRUE(rhs.run_optimize());
+			ASSERT_EQ(lhs, a);
+		}
+
+		check(lhs & rhs, [](auto... args) { return std::set_intersection(args...); });
+		check(lhs | rhs, [](auto... args) { return std::set_union(args...); });
+		check(lhs ^ rhs, [](auto... args) { return std::set_symmetric_difference(args...); });
+		check(lhs - rhs, [](auto... args) { return std::set_difference(args...); });
+
+		ASSERT_TRUE((lhs & rhs).is_subset_of(lhs));
+		ASSERT_TRUE((lhs & rhs).is_proper_subset_of(lhs));
+		ASSERT_TRUE(lhs.is_subset_of(lhs | rhs));
+		ASSERT_TRUE(lhs.is_subset_of(lhs));
+		ASSERT_FALSE(lhs.is_proper_subset_of(lhs));
+		ASSERT_FALSE(lhs.is_subset_of(rhs));
+		ASSERT_TRUE(lhs.is_intersects(rhs));
+		ASSERT_FALSE((lhs - rhs).is_intersects(rhs));
+		ASSERT_EQ((lhs ^ rhs) ^ rhs, lhs);
+
+		// modify a run container
+		auto outside_run = value_type{2 * 65536};
+		while (a_values.contains(outside_run)) { ++outside_run; }
+		lhs.set(outside_run);
+		ASSERT_TRUE(lhs.test(outside_run));
+		lhs.reset(outside_run);
+		ASSERT_EQ(lhs, a);
+	}
+}
+
+TEST(TestRoaringBitset, TestMemory)
+{
+	// a few thousand values spread over the whole universe, a basic_dynamic_bitset would take 512MB
+	roaring_bitset sparse;
+	for (value_type i = 0; i < 5000; ++i) { sparse.set(i * 858'993); }
+	sparse.shrink_to_fit();
+	ASSERT_LT(sparse.memory_usage(), static_cast<size_type>(5000 * 64));
+
+	// [0, 1M) is 16 full buckets, each becomes a single run
+	roaring_bitset dense;
+	for (value_type i = 0; i < 1'000'000; ++i) { dense.set(i); }
+	const auto before = dense.memory_usage();
+	ASSERT_TRUE(dense.run_optimize());
+	dense.shrink_to_fit();
+	ASSERT_LT(dense.memory_usage() * 100, before);
+	ASSERT_EQ(dense.count(), static_cast<size_type>(1'000'000));
+	ASSERT_EQ(dense.max(), static_cast<value_type>(999'999));
+	ASSERT_FALSE(dense.run_optimize());
+}
+
+TEST(TestRoaringBitset, TestDynamicBitset)
+{
+	// keep the dense bitset small
+	auto values = make_values(42);
+	std::erase_if(values, [](const value_type value) { return value >= 4 * 65536; });
+	const auto bitset = make_bitset(values);
+
+	const auto dense = bitset.to_dynamic_bitset();
+	ASSERT_EQ(dense.size(), static_cast<basic_dynamic_bitset::size_type>(bitset.max()) + 1);
+	ASSERT_EQ(dense.count(), values.size());
+	for (const auto value: values) { ASSERT_TRUE(dense.test(value)); }
+
+	ASSERT_EQ(roaring_bitset{dense}, bitset);
+	ASSERT_TRUE(roaring_bitset{basic_dynamic_bitset(100)}.empty());
+	ASSERT_EQ(roaring_bitset{}.to_dynamic_bitset().size(), static_cast<basic_dynamic_bitset::size_type>(0));
+}
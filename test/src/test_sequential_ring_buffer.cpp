@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/container/sequential_ring_buffer.hpp>
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+using namespace gal::toolbox::container;
+
+TEST(TestSequentialRingBuffer, TestPushAndPop)
+{
+	sequential_ring_buffer<int, 4> buffer_i4{};
+
+	ASSERT_TRUE(buffer_i4.empty());
+	ASSERT_EQ(buffer_i4.size(), static_cast<decltype(buffer_i4.size())>(0));
+
+	ASSERT_TRUE(buffer_i4.push(1));
+	ASSERT_TRUE(buffer_i4.push(2));
+	ASSERT_TRUE(buffer_i4.push(3));
+	ASSERT_TRUE(buffer_i4.push(4));
+	ASSERT_TRUE(buffer_i4.full());
+	ASSERT_FALSE(buffer_i4.push(5));
+	ASSERT_EQ(buffer_i4.size(), static_cast<decltype(buffer_i4.size())>(4));
+	ASSERT_EQ(buffer_i4.front(), 1);
+	ASSERT_EQ(buffer_i4.back(), 4);
+
+	int data{};
+	ASSERT_TRUE(buffer_i4.pop(data));
+	ASSERT_EQ(data, 1);
+	ASSERT_TRUE(buffer_i4.pop());
+	ASSERT_EQ(buffer_i4.size(), static_cast<decltype(buffer_i4.size())>(2));
+
+	// wrap around
+	ASSERT_TRUE(buffer_i4.push(5));
+	ASSERT_TRUE(buffer_i4.push(6));
+	ASSERT_TRUE(buffer_i4.full());
+	ASSERT_EQ(buffer_i4[0], 3);
+	ASSERT_EQ(buffer_i4[1], 4);
+	ASSERT_EQ(buffer_i4[2], 5);
+	ASSERT_EQ(buffer_i4[3], 6);
+
+	buffer_i4.clear();
+	ASSERT_TRUE(buffer_i4.empty());
+	ASSERT_FALSE(buffer_i4.pop());
+}
+
+TEST(TestSequentialRingBuffer, TestCopyAndMove)
+{
+	sequential_ring_buffer<std::string, 8> buffer_s8_1{};
+	ASSERT_TRUE(buffer_s8_1.push("one"));
+	ASSERT_TRUE(buffer_s8_1.push("two"));
+	ASSERT_TRUE(buffer_s8_1.push("three"));
+	ASSERT_TRUE(buffer_s8_1.pop());
+	ASSERT_TRUE(buffer_s8_1.push("four"));
+
+	decltype(buffer_s8_1) buffer_s8_2{buffer_s8_1};
+	ASSERT_EQ(buffer_s8_1, buffer_s8_2);
+	ASSERT_EQ(buffer_s8_2.size(), static_cast<decltype(buffer_s8_2.size())>(3));
+	ASSERT_EQ(buffer_s8_2.front(), "two");
+
+	decltype(buffer_s8_1) buffer_s8_3{std::move(buffer_s8_1)};
+	ASSERT_TRUE(buffer_s8_1.empty());
+	ASSERT_EQ(buffer_s8_3, buffer_s8_2);
+
+	buffer_s8_1 = std::move(buffer_s8_3);
+	ASSERT_EQ(buffer_s8_1, buffer_s8_2);
+
+	sequential_ring_buffer<int, 2> buffer_i2{};
+	ASSERT_TRUE(buffer_i2.push(1));
+	sequential_ring_buffer<long, 4> buffer_l4{buffer_i2};
+	ASSERT_EQ(buffer_l4.size(), static_cast<decltype(buffer_l4.size())>(1));
+	ASSERT_EQ(buffer_l4.front(), 1);
+}
+
+TEST(TestSequentialRingBuffer, TestSpans)
+{
+	sequential_ring_buffer<char, 8> buffer_c8{};
+
+	for (const auto c: std::string_view{"abcdef"}) { ASSERT_TRUE(buffer_c8.push(c)); }
+	buffer_c8.consume(4);
+	ASSERT_EQ(buffer_c8.size(), static_cast<decltype(buffer_c8.size())>(2));
+
+	// the free space wraps around
+	auto [first, second] = buffer_c8.writable_spans();
+	ASSERT_EQ(first.size() + second.size(), static_cast<decltype(first.size())>(6));
+	ASSERT_EQ(first.size(), static_cast<decltype(first.size())>(2));
+	std::ranges::copy(std::string_view{"gh"}, first.begin());
+	std::ranges::copy(std::string_view{"ijk"}, second.begin());
+	buffer_c8.commit(5);
+	ASSERT_EQ(buffer_c8.size(), static_cast<decltype(buffer_c8.size())>(7));
+
+	std::string out;
+	for (const auto span: buffer_c8.readable_spans()) { out.append(span.begin(), span.end()); }
+	ASSERT_EQ(out, "efghijk");
+
+	buffer_c8.consume(buffer_c8.size());
+	ASSERT_TRUE(buffer_c8.empty());
+}
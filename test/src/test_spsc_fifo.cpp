@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/container/spsc_fifo.hpp>
+#include <string>
+#include <thread>
+
+using namespace gal::toolbox::container;
+
+TEST(TestSpscFifo, TestPushAndPop)
+{
+	struct foo
+	{
+		int a;
+		int b;
+	};
+
+	spsc_fifo<foo, 4, std::allocator<foo>, true> fifo_f4{};
+
+	ASSERT_TRUE(fifo_f4.empty());
+
+	ASSERT_TRUE(fifo_f4.push());
+	ASSERT_TRUE(fifo_f4.push(1));
+	ASSERT_TRUE(fifo_f4.push(1, 2));
+	ASSERT_TRUE(fifo_f4.push());
+	ASSERT_EQ(fifo_f4.size(), static_cast<decltype(fifo_f4.size())>(4));
+	ASSERT_TRUE(fifo_f4.full());
+
+	// already full
+	ASSERT_FALSE(fifo_f4.push());
+	ASSERT_EQ(fifo_f4.size(), static_cast<decltype(fifo_f4.size())>(4));
+
+	ASSERT_TRUE(fifo_f4.pop());
+	ASSERT_EQ(fifo_f4.size(), static_cast<decltype(fifo_f4.size())>(3));
+
+	foo foo1{};
+	ASSERT_TRUE(fifo_f4.try_pop(foo1));
+	ASSERT_EQ(foo1.a, 1);
+	ASSERT_TRUE(fifo_f4.pop(foo1));
+	ASSERT_EQ(foo1.a, 1);
+	ASSERT_EQ(foo1.b, 2);
+	ASSERT_TRUE(fifo_f4.pop());
+
+	ASSERT_FALSE(fifo_f4.try_pop(foo1));
+	ASSERT_FALSE(fifo_f4.pop(static_cast<decltype(fifo_f4)::time_type>(-1)));
+	ASSERT_FALSE(fifo_f4.pop(10));
+	ASSERT_TRUE(fifo_f4.empty());
+}
+
+TEST(TestSpscFifo, TestNonTrivial)
+{
+	spsc_fifo<std::string, 8> fifo_s8{};
+
+	ASSERT_TRUE(fifo_s8.push("hello"));
+	ASSERT_TRUE(fifo_s8.push(std::string(100, 'x')));
+
+	// a non-blocking fifo pops with try_pop only
+	std::string s;
+	static_assert(not decltype(fifo_s8)::is_blocking);
+	ASSERT_TRUE(fifo_s8.try_pop(s));
+	ASSERT_EQ(s, "hello");
+
+	// the remaining string will be destroyed by the fifo
+}
+
+TEST(TestSpscFifo, TestProducerConsumer)
+{
+	constexpr int total = 100000;
+
+	spsc_fifo<int, 64, std::allocator<int>, true> fifo_i64{};
+
+	std::thread producer{
+			[&fifo_i64]
+			{
+				for (int i = 0; i < total; ++i)
+				{
+					while (not fifo_i64.push(i)) { std::this_thread::yield(); }
+				}
+			}};
+
+	bool in_order = true;
+	for (int i = 0; i < total; ++i)
+	{
+		int data{-1};
+		// mix the fast path and the blocking slow path
+		const bool popped = (i % 2 == 0) ? fifo_i64.pop(data) : fifo_i64.pop(data, 1000);
+		if (not popped or data != i) { in_order = false; }
+	}
+
+	producer.join();
+
+	ASSERT_TRUE(in_order);
+	ASSERT_TRUE(fifo_i64.empty());
+}
@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <galToolbox/string/string_pool.hpp>
+#include <cstring>
+#include <cwchar>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
 #include <vector>
 
 using namespace gal::toolbox::string;
@@ -216,3 +222,280 @@ TEST(TestStringPool, TestCustomeCapacity)
 		ASSERT_EQ(std::wcscmp(put_it_in.data(), L"a long long long long long long long long str"), 0);
 	}
 }
+
+TEST(TestStringPool, TestIntern)
+{
+	using pool_type = string_pool<char, true>;
+
+	pool_type pool{64};
+
+	const auto one = pool.intern("one");
+	const auto two = pool.intern(std::string{"two"});
+	// the same string gets the same view, no copy
+	ASSERT_EQ(pool.intern(std::string{"one"}).data(), one.data());
+	ASSERT_EQ(pool.intern("two").data(), two.data());
+	ASSERT_NE(one.data(), two.data());
+	ASSERT_STREQ(one.data(), "one");
+
+	const auto one_symbol = pool.intern_symbol("one");
+	ASSERT_EQ(pool.intern_symbol("one"), one_symbol);
+	ASSERT_NE(pool.intern_symbol("two"), one_symbol);
+	ASSERT_EQ(pool.symbol_view(one_symbol).data(), one.data());
+	ASSERT_EQ(pool.find_symbol("two"), pool.intern_symbol("two"));
+	ASSERT_EQ(pool.find_symbol("three"), pool_type::invalid_symbol);
+	ASSERT_EQ(pool.symbol_size(), static_cast<pool_type::size_type>(2));
+
+	// append never deduplicates
+	ASSERT_NE(pool.append("one").data(), one.data());
+	ASSERT_EQ(pool.intern("one").data(), one.data());
+
+	// many strings, many blocks, the intern table grows a few times
+	std::vector<std::string> strings;
+	std::vector<pool_type::symbol_type> symbols;
+	for (int i = 0; i < 10'000; ++i)
+	{
+		strings.push_back("tag-" + std::to_string(i));
+		symbols.push_back(pool.intern_symbol(strings.back()));
+	}
+	ASSERT_EQ(pool.symbol_size(), static_cast<pool_type::size_type>(10'002));
+	for (int round = 0; round < 3; ++round)
+	{
+		for (std::size_t i = 0; i < strings.size(); ++i)
+		{
+			ASSERT_EQ(pool.intern_symbol(strings[i]), symbols[i]);
+			ASSERT_EQ(pool.symbol_view(symbols[i]), strings[i]);
+		}
+	}
+	ASSERT_EQ(pool.symbol_size(), static_cast<pool_type::size_type>(10'002));
+	ASSERT_EQ(pool.intern("").size(), static_cast<pool_type::size_type>(0));
+	ASSERT_EQ(pool.intern("").data(), pool.intern("").data());
+
+	// the interned strings of another pool are ours after takeover
+	pool_type other{64};
+	const auto three = other.intern("three");
+	ASSERT_EQ(other.intern("one").size(), static_cast<pool_type::size_type>(3));
+	pool.takeover(std::move(other));
+	ASSERT_EQ(other.symbol_size(), static_cast<pool_type::size_type>(0));
+	ASSERT_EQ(pool.intern("three").data(), three.data());
+	ASSERT_EQ(pool.intern("one").data(), one.data());
+	ASSERT_EQ(pool.symbol_size(), static_cast<pool_type::size_type>(10'004));
+}
+
+namespace
+{
+	template<string_pool_block_policy Policy>
+	void check_block_policy()
+	{
+		using pool_type = string_pool<char, true, std::char_traits<char>, Policy>;
+
+		// the null terminator needs one more char, "abcd" does not fit the 4 chars left
+		pool_type small{8};
+		ASSERT_STREQ(small.append("abc").data(), "abc");
+		ASSERT_STREQ(small.append("abcd").data(), "abcd");
+		ASSERT_EQ(small.size(), static_cast<typename pool_type::size_type>(2));
+		// but "xyz" does
+		ASSERT_STREQ(small.append("xyz").data(), "xyz");
+		ASSERT_EQ(small.size(), static_cast<typename pool_type::size_type>(2));
+
+		pool_type pool{256};
+		std::mt19937 random{42};
+		std::vector<std::string> strings;
+		std::vector<std::string_view> views;
+		for (int i = 0; i < 5000; ++i)
+		{
+			strings.emplace_back(random() % 100, static_cast<char>('a' + i % 26));
+			views.push_back(pool.append(strings.back()));
+		}
+
+		pool_type other{256};
+		for (int i = 0; i < 500; ++i)
+		{
+			strings.emplace_back(random() % 300, static_cast<char>('A' + i % 26));
+			views.push_back(other.append(strings.back()));
+		}
+		pool.takeover(std::move(other));
+		for (int i = 0; i < 500; ++i)
+		{
+			strings.emplace_back(random() % 100, static_cast<char>('0' + i % 10));
+			views.push_back(pool.append(strings.back()));
+		}
+
+		for (std::size_t i = 0; i < strings.size(); ++i)
+		{
+			ASSERT_EQ(views[i], strings[i]) << i;
+			ASSERT_EQ(views[i].data()[views[i].size()], '\0') << i;
+		}
+	}
+}// namespace
+
+TEST(TestStringPool, TestBlockPolicy)
+{
+	check_block_policy<string_pool_block_policy::sorted>();
+	check_block_policy<string_pool_block_policy::size_class>();
+}
+
+namespace
+{
+	template<string_pool_block_policy Policy>
+	void check_block_borrower()
+	{
+		using pool_type = string_pool<char, true, std::char_traits<char>, Policy>;
+
+		pool_type pool{64};
+		const auto before = pool.append("before");
+
+		// the arena is released at once, the strings of the pool are never moved
+		{
+			auto borrower = pool.borrow_block();
+			const auto temp = borrower.append("temporary");
+			const auto after = pool.append("after");
+			const std::string long_string(100, 'l');
+			ASSERT_EQ(borrower.append(long_string), long_string);
+
+			auto raw = borrower.borrow_raw(3);
+			std::ranges::copy(std::string_view{"raw"}, raw);
+			ASSERT_STREQ(raw, "raw");
+			ASSERT_STREQ(temp.data(), "temporary");
+			// the long string has a block of its own
+			ASSERT_EQ(borrower.size(), static_cast<typename pool_type::size_type>(2));
+			ASSERT_EQ(temp.data() + temp.size() + 1, raw);
+
+			ASSERT_EQ(after.data(), before.data() + before.size() + 1);
+			ASSERT_EQ(pool.size(), static_cast<typename pool_type::size_type>(1));
+		}
+		ASSERT_STREQ(before.data(), "before");
+		ASSERT_EQ(pool.size(), static_cast<typename pool_type::size_type>(1));
+
+		// the arena is given to the pool
+		std::vector<std::string_view> kept;
+		{
+			auto borrower = pool.borrow_block();
+			kept.push_back(borrower.append("kept"));
+			borrower.break_promise();
+			ASSERT_FALSE(borrower.need_return());
+			ASSERT_EQ(pool.size(), static_cast<typename pool_type::size_type>(2));
+			// the later blocks are given when it is destroyed
+			kept.push_back(borrower.append(std::string(80, 'k')));
+		}
+		ASSERT_EQ(pool.size(), static_cast<typename pool_type::size_type>(3));
+		ASSERT_STREQ(kept[0].data(), "kept");
+		ASSERT_EQ(kept[1], std::string(80, 'k'));
+
+		// the pool still finds room in the blocks it was given
+		ASSERT_STREQ(pool.append("more").data(), "more");
+		ASSERT_EQ(pool.size(), static_cast<typename pool_type::size_type>(3));
+	}
+}// namespace
+
+TEST(TestStringPool, TestBlockBorrower)
+{
+	check_block_borrower<string_pool_block_policy::sorted>();
+	check_block_borrower<string_pool_block_policy::size_class>();
+}
+
+TEST(TestStringPool, TestSnapshot)
+{
+	using pool_type = string_pool<char>;
+
+	const auto path = std::filesystem::temp_directory_path() / "gal_string_pool_snapshot.bin";
+	const auto path_again = std::filesystem::temp_directory_path() / "gal_string_pool_snapshot_again.bin";
+
+	std::vector<std::string> strings;
+	{
+		pool_type pool{64};
+		for (int i = 0; i < 1000; ++i) { strings.push_back("string-" + std::to_string(i)); }
+		// some strings are in a block of their own
+		strings.emplace_back(200, 'x');
+		for (const auto& str: strings) { ASSERT_EQ(pool.symbol_view(pool.intern_symbol(str)), str); }
+		// not interned strings are saved too
+		static_cast<void>(pool.append("not interned"));
+
+		std::ofstream file{path, std::ios::binary};
+		pool.save(file);
+	}
+
+	{
+		auto opened = pool_type::open(path);
+		ASSERT_TRUE(opened.has_value());
+		auto& pool = *opened;
+
+		// nothing is copied, the views point into the file
+		ASSERT_EQ(pool.size(), static_cast<pool_type::size_type>(0));
+		ASSERT_EQ(pool.symbol_size(), strings.size());
+		for (pool_type::symbol_type i = 0; i < strings.size(); ++i)
+		{
+			ASSERT_EQ(pool.symbol_view(i), strings[i]);
+			ASSERT_STREQ(pool.symbol_view(i).data(), strings[i].c_str());
+			ASSERT_EQ(pool.find_symbol(strings[i]), i);
+			ASSERT_EQ(pool.intern(strings[i]).data(), pool.symbol_view(i).data());
+		}
+		ASSERT_EQ(pool.size(), static_cast<pool_type::size_type>(0));
+
+		// new strings go to the heap blocks
+		ASSERT_EQ(pool.find_symbol("new string"), pool_type::invalid_symbol);
+		ASSERT_EQ(pool.intern_symbol("new string"), static_cast<pool_type::symbol_type>(strings.size()));
+		ASSERT_EQ(pool.size(), static_cast<pool_type::size_type>(1));
+		strings.emplace_back("new string");
+
+		// the views live as long as the pool that takes it over
+		pool_type other;
+		other.takeover(std::move(pool));
+		for (pool_type::symbol_type i = 0; i < strings.size(); ++i) { ASSERT_EQ(other.intern(strings[i]), strings[i]); }
+		ASSERT_EQ(other.symbol_size(), strings.size());
+
+		// an opened snapshot can be saved again (but not over the file it holds)
+		std::ofstream file{path_again, std::ios::binary};
+		other.save(file);
+	}
+
+	{
+		const auto opened = pool_type::open(path_again);
+		ASSERT_TRUE(opened.has_value());
+		ASSERT_EQ(opened->symbol_size(), strings.size());
+		for (const auto& str: strings) { ASSERT_EQ(opened->symbol_view(opened->find_symbol(str)), str); }
+
+		// a snapshot of another kind of pool is rejected
+		ASSERT_FALSE((string_pool<char, false>::open(path_again).has_value()));
+		ASSERT_FALSE((string_pool<wchar_t>::open(path_again).has_value()));
+	}
+
+	// slots that do not map one to one onto the symbols are rejected (a lookup would probe forever)
+	{
+		using string_pool_detail::snapshot_header;
+		using string_pool_detail::snapshot_slot;
+
+		std::vector<char> bytes(std::filesystem::file_size(path_again));
+		std::ifstream{path_again, std::ios::binary}.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+		snapshot_header header;
+		std::memcpy(&header, bytes.data(), sizeof(header));
+
+		const auto corrupt = [&](const auto& modify)
+		{
+			auto copy = bytes;
+			for (std::uint64_t i = 0; i < header.slot_count; ++i)
+			{
+				snapshot_slot slot;
+				std::memcpy(&slot, copy.data() + header.slots_offset() + i * sizeof(slot), sizeof(slot));
+				if (slot.symbol not_eq pool_type::invalid_symbol) { modify(slot); }
+				std::memcpy(copy.data() + header.slots_offset() + i * sizeof(slot), &slot, sizeof(slot));
+			}
+			std::ofstream{path_again, std::ios::binary}.write(copy.data(), static_cast<std::streamsize>(copy.size()));
+			return pool_type::open(path_again).has_value();
+		};
+
+		// every slot points to the same symbol
+		ASSERT_FALSE(corrupt([](snapshot_slot& slot) { slot.symbol = 0; }));
+		// a symbol without a slot
+		ASSERT_FALSE(corrupt([](snapshot_slot& slot) { if (slot.symbol == 0) { slot.symbol = pool_type::invalid_symbol; } }));
+		// untouched
+		ASSERT_TRUE(corrupt([](snapshot_slot&) {}));
+	}
+	std::filesystem::remove(path_again);
+
+	// a truncated file is rejected
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+	ASSERT_FALSE(pool_type::open(path).has_value());
+	ASSERT_FALSE(pool_type::open(path.string() + ".not_exists").has_value());
+
+	std::filesystem::remove(path);
+}
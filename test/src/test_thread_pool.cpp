@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/utils/thread_pool.hpp>
+#include <atomic>
+#include <stdexcept>
+
+using namespace gal::toolbox::utils;
+
+TEST(TestThreadPool, TestSubmit)
+{
+	thread_pool pool{4};
+	ASSERT_EQ(pool.size(), static_cast<decltype(pool.size())>(4));
+
+	std::atomic<int> counter{0};
+	for (int i = 0; i < 10000; ++i) { pool.submit([&counter] { ++counter; }); }
+
+	pool.wait();
+	ASSERT_EQ(counter.load(), 10000);
+
+	// the pool can be reused after waiting
+	for (int i = 0; i < 100; ++i) { pool.submit([&counter] { ++counter; }); }
+	pool.wait();
+	ASSERT_EQ(counter.load(), 10100);
+}
+
+TEST(TestThreadPool, TestNestedSubmit)
+{
+	std::atomic<long long> sum{0};
+
+	{
+		thread_pool pool{4};
+
+		// every task splits itself until the range is small enough, the sub-tasks go to the worker's own deque and get stolen by the others
+		struct splitter
+		{
+			thread_pool& pool;
+			std::atomic<long long>& sum;
+			int begin;
+			int end;
+
+			void operator()() const
+			{
+				if (end - begin <= 16)
+				{
+					for (int i = begin; i < end; ++i) { sum += i; }
+					return;
+				}
+
+				const auto middle = begin + (end - begin) / 2;
+				pool.submit(splitter{pool, sum, begin, middle});
+				pool.submit(splitter{pool, sum, middle, end});
+			}
+		};
+
+		pool.submit(splitter{pool, sum, 0, 100000});
+		// the destructor finishes all tasks
+	}
+
+	ASSERT_EQ(sum.load(), 100000LL * (100000 - 1) / 2);
+}
+
+TEST(TestThreadPool, TestException)
+{
+	thread_pool pool{4};
+
+	std::atomic<int> counter{0};
+	for (int i = 0; i < 1000; ++i)
+	{
+		pool.submit(
+				[&counter, i]
+				{
+					if (i % 100 == 0) { throw std::runtime_error{"task failed"}; }
+					++counter;
+				});
+	}
+
+	// the other tasks still run, wait returns and rethrows one of the exceptions
+	ASSERT_THROW(pool.wait(), std::runtime_error);
+	ASSERT_EQ(counter.load(), 990);
+
+	// the exception is only rethrown once
+	pool.submit([&counter] { ++counter; });
+	ASSERT_NO_THROW(pool.wait());
+	ASSERT_EQ(counter.load(), 991);
+}
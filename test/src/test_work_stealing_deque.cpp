@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <galToolbox/container/work_stealing_deque.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace gal::toolbox::container;
+
+TEST(TestWorkStealingDeque, TestPushPopAndSteal)
+{
+	work_stealing_deque<int> deque{4};
+
+	ASSERT_TRUE(deque.empty());
+	ASSERT_EQ(deque.capacity(), static_cast<decltype(deque.capacity())>(4));
+
+	for (int i = 0; i < 4; ++i) { deque.push(i); }
+	ASSERT_EQ(deque.size(), static_cast<decltype(deque.size())>(4));
+
+	int data{};
+	// the owner pops the newest
+	ASSERT_TRUE(deque.pop(data));
+	ASSERT_EQ(data, 3);
+	// the thieves steal the oldest
+	ASSERT_TRUE(deque.steal(data));
+	ASSERT_EQ(data, 0);
+
+	ASSERT_TRUE(deque.pop(data));
+	ASSERT_EQ(data, 2);
+	ASSERT_TRUE(deque.steal(data));
+	ASSERT_EQ(data, 1);
+
+	ASSERT_FALSE(deque.pop(data));
+	ASSERT_FALSE(deque.steal(data));
+	ASSERT_TRUE(deque.empty());
+}
+
+TEST(TestWorkStealingDeque, TestGrow)
+{
+	work_stealing_deque<int> deque{2};
+
+	// start in the middle of the array so that growing has to deal with wrapping around
+	int data{};
+	deque.push(-1);
+	ASSERT_TRUE(deque.steal(data));
+
+	for (int i = 0; i < 1000; ++i) { deque.push(i); }
+	ASSERT_EQ(deque.size(), static_cast<decltype(deque.size())>(1000));
+	ASSERT_EQ(deque.capacity(), static_cast<decltype(deque.capacity())>(1024));
+
+	for (int i = 0; i < 500; ++i)
+	{
+		ASSERT_TRUE(deque.steal(data));
+		ASSERT_EQ(data, i);
+	}
+	for (int i = 999; i >= 500; --i)
+	{
+		ASSERT_TRUE(deque.pop(data));
+		ASSERT_EQ(data, i);
+	}
+	ASSERT_TRUE(deque.empty());
+}
+
+TEST(TestWorkStealingDeque, TestOwnerAndThieves)
+{
+	constexpr int thieves = 3;
+	constexpr int total = 100000;
+
+	work_stealing_deque<int> deque{};
+
+	std::atomic<bool> done{false};
+	std::vector<std::atomic<int>> taken(total);
+	std::atomic<int> stolen{0};
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thieves; ++t)
+	{
+		threads.emplace_back(
+				[&]
+				{
+					int data{};
+					while (not done.load())
+					{
+						if (deque.steal(data))
+						{
+							++taken[data];
+							++stolen;
+						}
+						else { std::this_thread::yield(); }
+					}
+				});
+	}
+
+	// the owner pushes (and grows) and pops at the same time
+	int data{};
+	for (int i = 0; i < total; ++i)
+	{
+		deque.push(i);
+		if (i % 3 == 0 and deque.pop(data)) { ++taken[data]; }
+	}
+	while (deque.pop(data)) { ++taken[data]; }
+
+	// the thieves may still hold the last ones
+	while (not deque.empty()) { std::this_thread::yield(); }
+	done.store(true);
+	for (auto& thread: threads) { thread.join(); }
+
+	// every element is taken exactly once
+	for (int i = 0; i < total; ++i) { ASSERT_EQ(taken[i].load(), 1) << i; }
+}